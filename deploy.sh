@@ -16,6 +16,7 @@ usage() {
     echo "  monitor - Open serial monitor (115200 baud)"
     echo "  all     - Build, flash, and open monitor"
     echo "  sim     - Build and run SDL simulator on Mac (no board needed)"
+    echo "  bench   - Build simulator and run headless benchmarks (bench [scenario...])"
     echo ""
     echo "Default: flash"
 }
@@ -50,6 +51,13 @@ cmd_sim() {
     "$SCRIPT_DIR/.pio/build/native/program"
 }
 
+cmd_bench() {
+    echo "==> Building simulator..."
+    "$PIO" run -d "$SCRIPT_DIR" -e native
+    echo "==> Running headless benchmarks..."
+    "$SCRIPT_DIR/.pio/build/native/program" --bench "$@"
+}
+
 cmd_monitor() {
     echo "==> Opening serial monitor (Ctrl+C to exit)..."
     "$PIO" device monitor -d "$SCRIPT_DIR" -b 115200
@@ -63,6 +71,7 @@ case "$ACTION" in
     monitor) cmd_monitor ;;
     all)     cmd_flash; cmd_monitor ;;
     sim)     cmd_sim ;;
+    bench)   shift; cmd_bench "$@" ;;
     -h|--help|help) usage ;;
     *)
         echo "Unknown action: $ACTION"
@@ -6,9 +6,22 @@
 /* Color depth: 16-bit (RGB565) for RGB panel */
 #define LV_COLOR_DEPTH 16
 #define LV_COLOR_16_SWAP 1
-
-/* Memory */
+/* 16-bit fast mixing (opa rounded to the nearest 5-bit factor), which the
+ * draw kernels in blend_kernels.cpp reproduce bit for bit */
+#define LV_COLOR_MIX_ROUND_OFS 0
+
+/* Memory: small blocks from internal SRAM pools, large ones from PSRAM
+ * (tiered_alloc.h). -DLV_TIERED_ALLOC=0 puts everything in PSRAM again. */
+#ifndef LV_TIERED_ALLOC
+#define LV_TIERED_ALLOC 1
+#endif
 #define LV_MEM_CUSTOM 1
+#if LV_TIERED_ALLOC
+#define LV_MEM_CUSTOM_INCLUDE "tiered_alloc.h"
+#define LV_MEM_CUSTOM_ALLOC  tiered_malloc
+#define LV_MEM_CUSTOM_FREE   tiered_free
+#define LV_MEM_CUSTOM_REALLOC tiered_realloc
+#else
 #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>
 #ifdef SIMULATOR
 #define LV_MEM_CUSTOM_ALLOC  malloc
@@ -17,6 +30,7 @@
 #endif
 #define LV_MEM_CUSTOM_FREE   free
 #define LV_MEM_CUSTOM_REALLOC realloc
+#endif
 
 /* HAL */
 #define LV_TICK_CUSTOM 1
@@ -49,6 +63,26 @@
 #define LV_USE_ASSERT_MEM_INTEGRITY 0
 #define LV_USE_ASSERT_OBJ           0
 
+#if defined(UI_SUBSET_FONTS) && UI_SUBSET_FONTS
+/* Subset fonts generated by tools/gen_fonts.py replace the built-ins */
+#define LV_FONT_MONTSERRAT_12 0
+#define LV_FONT_MONTSERRAT_14 0
+#define LV_FONT_MONTSERRAT_16 0
+#define LV_FONT_MONTSERRAT_20 0
+#define LV_FONT_MONTSERRAT_24 0
+#define LV_FONT_MONTSERRAT_28 0
+#define LV_FONT_MONTSERRAT_32 0
+#define LV_FONT_MONTSERRAT_36 0
+#define LV_FONT_MONTSERRAT_40 0
+#define LV_FONT_MONTSERRAT_48 0
+
+/* Compressed variants are always generated (bench compares both) */
+#define LV_USE_FONT_COMPRESSED 1
+
+/* Default font */
+#define LV_FONT_CUSTOM_DECLARE LV_FONT_DECLARE(ui_font_montserrat_14)
+#define LV_FONT_DEFAULT &ui_font_montserrat_14
+#else
 /* Built-in fonts */
 #define LV_FONT_MONTSERRAT_12 1
 #define LV_FONT_MONTSERRAT_14 1
@@ -63,6 +97,7 @@
 
 /* Default font */
 #define LV_FONT_DEFAULT &lv_font_montserrat_14
+#endif
 
 /* Text */
 #define LV_TXT_ENC LV_TXT_ENC_UTF8
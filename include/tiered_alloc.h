@@ -0,0 +1,57 @@
+#ifndef TIERED_ALLOC_H
+#define TIERED_ALLOC_H
+
+/* LVGL heap (LV_MEM_CUSTOM_ALLOC/FREE/REALLOC in lv_conf.h), C linkage so
+ * LVGL's C sources can use it. Requests up to TIERED_POOL_MAX bytes come
+ * from fixed-size-class pools carved out of one internal SRAM block (objects,
+ * styles, timers, label text); larger ones go to PSRAM, falling back to
+ * internal RAM when there is none. The simulator builds the same code on the
+ * system heap. Not thread safe: LVGL task only. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIERED_POOL_MAX     128   /* largest pooled request (bytes) */
+#define TIERED_CLASS_COUNT  7
+
+typedef struct {
+    uint16_t block_size;
+    uint16_t capacity;     /* blocks in the pool */
+    uint16_t used;
+    uint16_t peak;
+    uint32_t allocs;
+    uint32_t overflows;    /* requests sent to the bulk heap because the pool was full */
+    uint32_t requested;    /* bytes asked for by live blocks (<= used * block_size) */
+} tiered_class_stats_t;
+
+typedef struct {
+    tiered_class_stats_t classes[TIERED_CLASS_COUNT];
+    size_t   pool_bytes;       /* SRAM arena size, 0 if it could not be allocated */
+    size_t   pool_used;        /* bytes in live pool blocks */
+    uint8_t  pool_waste_pct;   /* internal fragmentation: block bytes not requested */
+    size_t   bulk_used;        /* bytes in live bulk blocks */
+    size_t   bulk_peak;
+    uint32_t bulk_live;
+    uint32_t bulk_allocs;
+    uint32_t bulk_internal;    /* bulk blocks that landed in internal RAM (no PSRAM) */
+    size_t   heap_free;        /* bulk heap free bytes (0 = unknown, simulator) */
+    size_t   heap_largest;     /* largest free bulk heap block */
+    uint8_t  heap_frag_pct;    /* 100 - largest/free */
+} tiered_stats_t;
+
+void* tiered_malloc(size_t size);
+void  tiered_free(void* ptr);
+void* tiered_realloc(void* ptr, size_t size);
+
+void tiered_alloc_get_stats(tiered_stats_t* out);
+void tiered_alloc_dump(void);   /* per-class table to Serial */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIERED_ALLOC_H */
@@ -0,0 +1,569 @@
+#include "blend_kernels.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#define BLEND_X86 1
+#include <immintrin.h>
+#else
+#define BLEND_X86 0
+#endif
+
+static_assert(LV_COLOR_DEPTH == 16, "blend kernels are RGB565 only");
+static_assert(LV_COLOR_MIX_ROUND_OFS == 0, "blend kernels reproduce the 16-bit fast lv_color_mix()");
+
+static const char* TAG = "BLEND";
+
+#define MIX_MASK 0x07E0F81Fu   // G << 21 | R << 11 | B, as in lv_color_mix()
+
+// Buffer word <-> RGB565 value
+static inline uint16_t to565(uint16_t px) {
+#if LV_COLOR_16_SWAP
+    return (uint16_t)(px << 8 | px >> 8);
+#else
+    return px;
+#endif
+}
+
+// Factor of a masked pixel, as lv_draw_sw_blend_basic() picks it: the mask
+// alone once opa is (nearly) opaque, with different thresholds for fills and
+// images
+static inline uint8_t fill_coverage(uint8_t opa, uint8_t mask) {
+    if (opa >= LV_OPA_MAX) return mask;
+    return mask == LV_OPA_COVER ? opa : (uint8_t)((mask * opa) >> 8);
+}
+
+static inline uint8_t map_coverage(uint8_t opa, uint8_t mask) {
+    if (opa > LV_OPA_MAX) return mask;
+    return mask >= LV_OPA_MAX ? opa : (uint8_t)((mask * opa) >> 8);
+}
+
+// ----- Scalar reference -----
+uint16_t blend_mix565(uint16_t fg, uint16_t bg, uint8_t mix) {
+    uint32_t f = to565(fg);
+    uint32_t b = to565(bg);
+    uint32_t m = ((uint32_t)mix + 4) >> 3;
+    f = (f | f << 16) & MIX_MASK;
+    b = (b | b << 16) & MIX_MASK;
+    uint32_t r = ((((f - b) * m) >> 5) + b) & MIX_MASK;
+    return to565((uint16_t)(r >> 16 | r));
+}
+
+// Unmasked translucent fills go through lv_color_premult() and
+// lv_color_mix_premult() instead, with opa first rounded to the 5-bit step
+// lv_color_mix() uses: per channel (c * opa + bg * (255 - opa)) / 255,
+// rounded down (LV_UDIV255)
+struct Premult {
+    uint16_t r, g, b;
+    uint16_t inv;
+};
+
+static Premult premult(uint16_t color, uint8_t opa) {
+    uint8_t o = (uint8_t)(((opa + 4u) >> 3) << 3);   // an lv_opa_t there too: 252 wraps to 0
+    uint16_t c = to565(color);
+    return {(uint16_t)((c >> 11) * o), (uint16_t)((c >> 5 & 0x3F) * o), (uint16_t)((c & 0x1F) * o),
+            (uint16_t)(255 - o)};
+}
+
+static inline uint32_t udiv255(uint32_t x) {
+    return (x * 0x8081u) >> 23;
+}
+
+static inline uint16_t mix_premult(const Premult& p, uint16_t bg) {
+    uint16_t b = to565(bg);
+    uint32_t r = udiv255(p.r + (b >> 11) * p.inv);
+    uint32_t g = udiv255(p.g + (b >> 5 & 0x3F) * p.inv);
+    uint32_t bl = udiv255(p.b + (b & 0x1F) * p.inv);
+    return to565((uint16_t)(r << 11 | g << 5 | bl));
+}
+
+// LVGL seeds that fill's result cache with black mixed by lv_color_mix() at
+// the unrounded opa, so black pixels before the first other one get that
+// color. Blends the rows up to and including the one with the first other
+// pixel; returns how many.
+static int32_t fill_black_lead(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                               const Premult& p) {
+    uint16_t seed = blend_mix565(color, 0, opa);
+    for (int32_t y = 0; y < h; y++, dst += stride) {
+        for (int32_t x = 0; x < w; x++) {
+            if (dst[x]) {
+                for (; x < w; x++) dst[x] = mix_premult(p, dst[x]);
+                return y + 1;
+            }
+            dst[x] = seed;
+        }
+    }
+    return h;
+}
+
+static void fill_scalar(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    for (int32_t y = 0; y < h; y++, dst += stride) {
+        for (int32_t x = 0; x < w; x++) dst[x] = color;
+    }
+}
+
+static void fill_blend_scalar(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                              const uint8_t* mask, int32_t mask_stride) {
+    if (!mask) {
+        Premult p = premult(color, opa);
+        int32_t lead = fill_black_lead(dst, stride, w, h, color, opa, p);
+        dst += stride * lead;
+        for (int32_t y = lead; y < h; y++, dst += stride) {
+            for (int32_t x = 0; x < w; x++) dst[x] = mix_premult(p, dst[x]);
+        }
+        return;
+    }
+    for (int32_t y = 0; y < h; y++, dst += stride, mask += mask_stride) {
+        for (int32_t x = 0; x < w; x++) dst[x] = blend_mix565(color, dst[x], fill_coverage(opa, mask[x]));
+    }
+}
+
+static void map_blend_scalar(uint16_t* dst, int32_t stride, const uint16_t* src, int32_t src_stride, int32_t w,
+                             int32_t h, uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    for (int32_t y = 0; y < h; y++, dst += stride, src += src_stride) {
+        for (int32_t x = 0; x < w; x++) dst[x] = blend_mix565(src[x], dst[x], mask ? map_coverage(opa, mask[x]) : opa);
+        if (mask) mask += mask_stride;
+    }
+}
+
+// ----- SWAR: one pixel per 32-bit word, two per store -----
+// A 5-bit factor of 0 keeps the destination and 32 gives the source exactly,
+// so both skip the arithmetic.
+static inline uint32_t expand(uint16_t px) {
+    uint32_t c = to565(px);
+    return (c | c << 16) & MIX_MASK;
+}
+
+static inline uint16_t mix_expanded(uint32_t fx, uint16_t bg, uint32_t m) {
+    uint32_t bx = expand(bg);
+    uint32_t r = ((((fx - bx) * m) >> 5) + bx) & MIX_MASK;
+    return to565((uint16_t)(r >> 16 | r));
+}
+
+static inline bool mask_clear4(const uint8_t* mask, int32_t x, int32_t w) {
+    if (!mask || (x & 3) || x + 4 > w) return false;
+    uint32_t word;
+    memcpy(&word, mask + x, 4);
+    return word == 0;
+}
+
+static void fill_swar(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    uint32_t pair = (uint32_t)color << 16 | color;
+    for (int32_t y = 0; y < h; y++, dst += stride) {
+        uint16_t* p = dst;
+        int32_t n = w;
+        if (((uintptr_t)p & 2) && n) {
+            *p++ = color;
+            n--;
+        }
+        for (; n >= 2; n -= 2, p += 2) memcpy(p, &pair, 4);
+        if (n) *p = color;
+    }
+}
+
+static void fill_blend_swar(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                            const uint8_t* mask, int32_t mask_stride) {
+    // Backgrounds are mostly flat: reuse the last result while the input repeats
+    uint16_t last_bg = 0;
+    if (!mask) {
+        Premult p = premult(color, opa);
+        int32_t lead = fill_black_lead(dst, stride, w, h, color, opa, p);
+        dst += stride * lead;
+        uint16_t last_res = mix_premult(p, last_bg);
+        for (int32_t y = lead; y < h; y++, dst += stride) {
+            for (int32_t x = 0; x < w; x++) {
+                if (dst[x] != last_bg) {
+                    last_bg = dst[x];
+                    last_res = mix_premult(p, last_bg);
+                }
+                dst[x] = last_res;
+            }
+        }
+        return;
+    }
+
+    uint32_t fx = expand(color);
+    uint32_t last_m = 0;
+    uint16_t last_res = mix_expanded(fx, last_bg, last_m);
+    for (int32_t y = 0; y < h; y++, dst += stride, mask += mask_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            if (mask_clear4(mask, x, w)) {
+                x += 3;
+                continue;
+            }
+            uint32_t m = (fill_coverage(opa, mask[x]) + 4u) >> 3;
+            if (m == 0) continue;
+            if (m == 32) {
+                dst[x] = color;
+                continue;
+            }
+            if (dst[x] != last_bg || m != last_m) {
+                last_bg = dst[x];
+                last_m = m;
+                last_res = mix_expanded(fx, last_bg, m);
+            }
+            dst[x] = last_res;
+        }
+    }
+}
+
+static void map_blend_swar(uint16_t* dst, int32_t stride, const uint16_t* src, int32_t src_stride, int32_t w,
+                           int32_t h, uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    uint32_t m_opa = (opa + 4u) >> 3;
+    for (int32_t y = 0; y < h; y++, dst += stride, src += src_stride) {
+        for (int32_t x = 0; x < w; x++) {
+            if (mask_clear4(mask, x, w)) {
+                x += 3;
+                continue;
+            }
+            uint32_t m = mask ? (map_coverage(opa, mask[x]) + 4u) >> 3 : m_opa;
+            if (m == 0) continue;
+            dst[x] = m == 32 ? src[x] : mix_expanded(expand(src[x]), dst[x], m);
+        }
+        if (mask) mask += mask_stride;
+    }
+}
+
+#if BLEND_X86
+// ----- SSE2 / AVX2: channels unpacked into 16-bit lanes -----
+// Per channel b + ((f - b) * m >> 5), arithmetic shift: the same floor the
+// packed 32-bit formula takes. |f - b| * m <= 63 * 32 fits an int16. The
+// premultiplied mix stays below 63 * 255, where mulhi by 0x8081 and >> 7 is
+// LV_UDIV255.
+#define AVX2 __attribute__((target("avx2")))
+
+// Lanes whose mask byte is above this take opa itself (unless raw)
+#define FILL_COVER_ABOVE (LV_OPA_COVER - 1)
+#define MAP_COVER_ABOVE  (LV_OPA_MAX - 1)
+
+static inline __m128i swap_sse2(__m128i v) {
+#if LV_COLOR_16_SWAP
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#else
+    return v;
+#endif
+}
+
+static inline __m128i mix_sse2(__m128i f, __m128i b, __m128i m) {
+    const __m128i six = _mm_set1_epi16(0x3F), five = _mm_set1_epi16(0x1F);
+    __m128i br = _mm_srli_epi16(b, 11);
+    __m128i bg = _mm_and_si128(_mm_srli_epi16(b, 5), six);
+    __m128i bb = _mm_and_si128(b, five);
+    __m128i r = _mm_sub_epi16(_mm_srli_epi16(f, 11), br);
+    __m128i g = _mm_sub_epi16(_mm_and_si128(_mm_srli_epi16(f, 5), six), bg);
+    __m128i bl = _mm_sub_epi16(_mm_and_si128(f, five), bb);
+    r = _mm_add_epi16(br, _mm_srai_epi16(_mm_mullo_epi16(r, m), 5));
+    g = _mm_add_epi16(bg, _mm_srai_epi16(_mm_mullo_epi16(g, m), 5));
+    bl = _mm_add_epi16(bb, _mm_srai_epi16(_mm_mullo_epi16(bl, m), 5));
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), bl);
+}
+
+static inline __m128i premult_sse2(__m128i b, const Premult& p) {
+    const __m128i six = _mm_set1_epi16(0x3F), five = _mm_set1_epi16(0x1F), div = _mm_set1_epi16((short)0x8081);
+    __m128i inv = _mm_set1_epi16((short)p.inv);
+    __m128i r = _mm_add_epi16(_mm_set1_epi16((short)p.r), _mm_mullo_epi16(_mm_srli_epi16(b, 11), inv));
+    __m128i g = _mm_add_epi16(_mm_set1_epi16((short)p.g), _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(b, 5), six), inv));
+    __m128i bl = _mm_add_epi16(_mm_set1_epi16((short)p.b), _mm_mullo_epi16(_mm_and_si128(b, five), inv));
+    r = _mm_srli_epi16(_mm_mulhi_epu16(r, div), 7);
+    g = _mm_srli_epi16(_mm_mulhi_epu16(g, div), 7);
+    bl = _mm_srli_epi16(_mm_mulhi_epu16(bl, div), 7);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), bl);
+}
+
+// 5-bit factor per lane from 8 mask bytes, as fill_coverage()/map_coverage()
+static inline __m128i factor_sse2(__m128i mask16, __m128i opa16, bool raw, int cover_above) {
+    __m128i a = mask16;
+    if (!raw) {
+        __m128i scaled = _mm_srli_epi16(_mm_mullo_epi16(mask16, opa16), 8);
+        __m128i full = _mm_cmpgt_epi16(mask16, _mm_set1_epi16((short)cover_above));
+        a = _mm_or_si128(_mm_and_si128(full, opa16), _mm_andnot_si128(full, scaled));
+    }
+    return _mm_srli_epi16(_mm_add_epi16(a, _mm_set1_epi16(4)), 3);
+}
+
+static void fill_sse2(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    __m128i c = _mm_set1_epi16((short)color);
+    for (int32_t y = 0; y < h; y++, dst += stride) {
+        int32_t x = 0;
+        for (; x + 8 <= w; x += 8) _mm_storeu_si128((__m128i*)(dst + x), c);
+        for (; x < w; x++) dst[x] = color;
+    }
+}
+
+static void fill_blend_sse2(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                            const uint8_t* mask, int32_t mask_stride) {
+    if (!mask) {
+        Premult p = premult(color, opa);
+        int32_t lead = fill_black_lead(dst, stride, w, h, color, opa, p);
+        dst += stride * lead;
+        for (int32_t y = lead; y < h; y++, dst += stride) {
+            int32_t x = 0;
+            for (; x + 8 <= w; x += 8) {
+                __m128i* q = (__m128i*)(dst + x);
+                _mm_storeu_si128(q, swap_sse2(premult_sse2(swap_sse2(_mm_loadu_si128(q)), p)));
+            }
+            for (; x < w; x++) dst[x] = mix_premult(p, dst[x]);
+        }
+        return;
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    __m128i f = _mm_set1_epi16((short)to565(color));
+    __m128i opa16 = _mm_set1_epi16(opa);
+    bool raw = opa >= LV_OPA_MAX;
+    for (int32_t y = 0; y < h; y++, dst += stride, mask += mask_stride) {
+        int32_t x = 0;
+        for (; x + 8 <= w; x += 8) {
+            __m128i mk = _mm_loadl_epi64((const __m128i*)(mask + x));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(mk, zero)) == 0xFFFF) continue;
+            __m128i m = factor_sse2(_mm_unpacklo_epi8(mk, zero), opa16, raw, FILL_COVER_ABOVE);
+            __m128i* q = (__m128i*)(dst + x);
+            _mm_storeu_si128(q, swap_sse2(mix_sse2(f, swap_sse2(_mm_loadu_si128(q)), m)));
+        }
+        for (; x < w; x++) dst[x] = blend_mix565(color, dst[x], fill_coverage(opa, mask[x]));
+    }
+}
+
+static void map_blend_sse2(uint16_t* dst, int32_t stride, const uint16_t* src, int32_t src_stride, int32_t w,
+                           int32_t h, uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i opa16 = _mm_set1_epi16(opa);
+    __m128i m_opa = _mm_set1_epi16((opa + 4) >> 3);
+    bool raw = opa > LV_OPA_MAX;
+    for (int32_t y = 0; y < h; y++, dst += stride, src += src_stride) {
+        int32_t x = 0;
+        for (; x + 8 <= w; x += 8) {
+            __m128i m = m_opa;
+            if (mask) {
+                __m128i mk = _mm_loadl_epi64((const __m128i*)(mask + x));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(mk, zero)) == 0xFFFF) continue;
+                m = factor_sse2(_mm_unpacklo_epi8(mk, zero), opa16, raw, MAP_COVER_ABOVE);
+            }
+            __m128i f = swap_sse2(_mm_loadu_si128((const __m128i*)(src + x)));
+            __m128i* q = (__m128i*)(dst + x);
+            _mm_storeu_si128(q, swap_sse2(mix_sse2(f, swap_sse2(_mm_loadu_si128(q)), m)));
+        }
+        for (; x < w; x++) dst[x] = blend_mix565(src[x], dst[x], mask ? map_coverage(opa, mask[x]) : opa);
+        if (mask) mask += mask_stride;
+    }
+}
+
+AVX2 static inline __m256i swap_avx2(__m256i v) {
+#if LV_COLOR_16_SWAP
+    return _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+#else
+    return v;
+#endif
+}
+
+AVX2 static inline __m256i mix_avx2(__m256i f, __m256i b, __m256i m) {
+    const __m256i six = _mm256_set1_epi16(0x3F), five = _mm256_set1_epi16(0x1F);
+    __m256i br = _mm256_srli_epi16(b, 11);
+    __m256i bg = _mm256_and_si256(_mm256_srli_epi16(b, 5), six);
+    __m256i bb = _mm256_and_si256(b, five);
+    __m256i r = _mm256_sub_epi16(_mm256_srli_epi16(f, 11), br);
+    __m256i g = _mm256_sub_epi16(_mm256_and_si256(_mm256_srli_epi16(f, 5), six), bg);
+    __m256i bl = _mm256_sub_epi16(_mm256_and_si256(f, five), bb);
+    r = _mm256_add_epi16(br, _mm256_srai_epi16(_mm256_mullo_epi16(r, m), 5));
+    g = _mm256_add_epi16(bg, _mm256_srai_epi16(_mm256_mullo_epi16(g, m), 5));
+    bl = _mm256_add_epi16(bb, _mm256_srai_epi16(_mm256_mullo_epi16(bl, m), 5));
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), bl);
+}
+
+AVX2 static inline __m256i premult_avx2(__m256i b, const Premult& p) {
+    const __m256i six = _mm256_set1_epi16(0x3F), five = _mm256_set1_epi16(0x1F);
+    const __m256i div = _mm256_set1_epi16((short)0x8081);
+    __m256i inv = _mm256_set1_epi16((short)p.inv);
+    __m256i r = _mm256_add_epi16(_mm256_set1_epi16((short)p.r), _mm256_mullo_epi16(_mm256_srli_epi16(b, 11), inv));
+    __m256i g = _mm256_add_epi16(_mm256_set1_epi16((short)p.g),
+                                 _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(b, 5), six), inv));
+    __m256i bl = _mm256_add_epi16(_mm256_set1_epi16((short)p.b), _mm256_mullo_epi16(_mm256_and_si256(b, five), inv));
+    r = _mm256_srli_epi16(_mm256_mulhi_epu16(r, div), 7);
+    g = _mm256_srli_epi16(_mm256_mulhi_epu16(g, div), 7);
+    bl = _mm256_srli_epi16(_mm256_mulhi_epu16(bl, div), 7);
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), bl);
+}
+
+AVX2 static inline __m256i factor_avx2(__m256i mask16, __m256i opa16, bool raw, int cover_above) {
+    __m256i a = mask16;
+    if (!raw) {
+        __m256i scaled = _mm256_srli_epi16(_mm256_mullo_epi16(mask16, opa16), 8);
+        __m256i full = _mm256_cmpgt_epi16(mask16, _mm256_set1_epi16((short)cover_above));
+        a = _mm256_blendv_epi8(scaled, opa16, full);
+    }
+    return _mm256_srli_epi16(_mm256_add_epi16(a, _mm256_set1_epi16(4)), 3);
+}
+
+AVX2 static void fill_avx2(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color) {
+    __m256i c = _mm256_set1_epi16((short)color);
+    for (int32_t y = 0; y < h; y++, dst += stride) {
+        int32_t x = 0;
+        for (; x + 16 <= w; x += 16) _mm256_storeu_si256((__m256i*)(dst + x), c);
+        for (; x < w; x++) dst[x] = color;
+    }
+}
+
+AVX2 static void fill_blend_avx2(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                                 const uint8_t* mask, int32_t mask_stride) {
+    if (!mask) {
+        Premult p = premult(color, opa);
+        int32_t lead = fill_black_lead(dst, stride, w, h, color, opa, p);
+        dst += stride * lead;
+        for (int32_t y = lead; y < h; y++, dst += stride) {
+            int32_t x = 0;
+            for (; x + 16 <= w; x += 16) {
+                __m256i* q = (__m256i*)(dst + x);
+                _mm256_storeu_si256(q, swap_avx2(premult_avx2(swap_avx2(_mm256_loadu_si256(q)), p)));
+            }
+            for (; x < w; x++) dst[x] = mix_premult(p, dst[x]);
+        }
+        return;
+    }
+
+    __m256i f = _mm256_set1_epi16((short)to565(color));
+    __m256i opa16 = _mm256_set1_epi16(opa);
+    bool raw = opa >= LV_OPA_MAX;
+    for (int32_t y = 0; y < h; y++, dst += stride, mask += mask_stride) {
+        int32_t x = 0;
+        for (; x + 16 <= w; x += 16) {
+            __m128i mk = _mm_loadu_si128((const __m128i*)(mask + x));
+            if (_mm_testz_si128(mk, mk)) continue;
+            __m256i m = factor_avx2(_mm256_cvtepu8_epi16(mk), opa16, raw, FILL_COVER_ABOVE);
+            __m256i* q = (__m256i*)(dst + x);
+            _mm256_storeu_si256(q, swap_avx2(mix_avx2(f, swap_avx2(_mm256_loadu_si256(q)), m)));
+        }
+        for (; x < w; x++) dst[x] = blend_mix565(color, dst[x], fill_coverage(opa, mask[x]));
+    }
+}
+
+AVX2 static void map_blend_avx2(uint16_t* dst, int32_t stride, const uint16_t* src, int32_t src_stride, int32_t w,
+                                int32_t h, uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    __m256i opa16 = _mm256_set1_epi16(opa);
+    __m256i m_opa = _mm256_set1_epi16((opa + 4) >> 3);
+    bool raw = opa > LV_OPA_MAX;
+    for (int32_t y = 0; y < h; y++, dst += stride, src += src_stride) {
+        int32_t x = 0;
+        for (; x + 16 <= w; x += 16) {
+            __m256i m = m_opa;
+            if (mask) {
+                __m128i mk = _mm_loadu_si128((const __m128i*)(mask + x));
+                if (_mm_testz_si128(mk, mk)) continue;
+                m = factor_avx2(_mm256_cvtepu8_epi16(mk), opa16, raw, MAP_COVER_ABOVE);
+            }
+            __m256i f = swap_avx2(_mm256_loadu_si256((const __m256i*)(src + x)));
+            __m256i* q = (__m256i*)(dst + x);
+            _mm256_storeu_si256(q, swap_avx2(mix_avx2(f, swap_avx2(_mm256_loadu_si256(q)), m)));
+        }
+        for (; x < w; x++) dst[x] = blend_mix565(src[x], dst[x], mask ? map_coverage(opa, mask[x]) : opa);
+        if (mask) mask += mask_stride;
+    }
+}
+#endif
+
+// ----- Variant table -----
+static const BlendKernels VARIANTS[] = {
+    {"scalar", fill_scalar, fill_blend_scalar, map_blend_scalar},
+    {"swar",   fill_swar,   fill_blend_swar,   map_blend_swar},
+#if BLEND_X86
+    {"sse2",   fill_sse2,   fill_blend_sse2,   map_blend_sse2},
+    {"avx2",   fill_avx2,   fill_blend_avx2,   map_blend_avx2},
+#endif
+};
+static const int VARIANT_COUNT = sizeof(VARIANTS) / sizeof(VARIANTS[0]);
+
+int blend_kernels_count() {
+    return VARIANT_COUNT;
+}
+
+const BlendKernels* blend_kernels_get(int i) {
+    return i >= 0 && i < VARIANT_COUNT ? &VARIANTS[i] : nullptr;
+}
+
+bool blend_kernels_supported(int i) {
+    if (i < 0 || i >= VARIANT_COUNT) return false;
+#if BLEND_X86
+    if (strcmp(VARIANTS[i].name, "avx2") == 0) return __builtin_cpu_supports("avx2");
+#endif
+    return true;
+}
+
+const BlendKernels* blend_kernels_best() {
+    int i = VARIANT_COUNT - 1;
+    while (i > 0 && !blend_kernels_supported(i)) i--;
+    return &VARIANTS[i];
+}
+
+// ----- Draw context hook -----
+static void (*prev_ctx_init)(lv_disp_drv_t*, lv_draw_ctx_t*) = nullptr;
+static const BlendKernels* active = nullptr;
+
+// lv_draw_sw_blend_basic() for normal blending into an opaque RGB565 buffer;
+// everything else (other blend modes, alpha layers, set_px_cb) stays with it
+static void kernel_blend(lv_draw_ctx_t* draw_ctx, const lv_draw_sw_blend_dsc_t* dsc) {
+    const BlendKernels* k = active;
+    const lv_disp_drv_t* drv = _lv_refr_get_disp_refreshing()->driver;
+    if (!k || dsc->blend_mode != LV_BLEND_MODE_NORMAL || drv->screen_transp || drv->set_px_cb) {
+        lv_draw_sw_blend_basic(draw_ctx, dsc);
+        return;
+    }
+
+    const lv_opa_t* mask = dsc->mask_buf;
+    if (mask && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+    if (dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER) mask = nullptr;
+
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) return;
+    int32_t w = lv_area_get_width(&area);
+    int32_t h = lv_area_get_height(&area);
+
+    const lv_area_t* buf_area = draw_ctx->buf_area;
+    int32_t stride = lv_area_get_width(buf_area);
+    uint16_t* dst = (uint16_t*)draw_ctx->buf + stride * (area.y1 - buf_area->y1) + (area.x1 - buf_area->x1);
+
+    int32_t mask_stride = 0;
+    if (mask) {
+        mask_stride = lv_area_get_width(dsc->mask_area);
+        mask += mask_stride * (area.y1 - dsc->mask_area->y1) + (area.x1 - dsc->mask_area->x1);
+    }
+
+    if (!dsc->src_buf) {
+        if (!mask && dsc->opa >= LV_OPA_MAX) k->fill(dst, stride, w, h, dsc->color.full);
+        else k->fill_blend(dst, stride, w, h, dsc->color.full, dsc->opa, mask, mask_stride);
+        return;
+    }
+
+    int32_t src_stride = lv_area_get_width(dsc->blend_area);
+    const uint16_t* src = (const uint16_t*)dsc->src_buf + src_stride * (area.y1 - dsc->blend_area->y1) +
+                          (area.x1 - dsc->blend_area->x1);
+    if (!mask && dsc->opa >= LV_OPA_MAX) {
+        for (int32_t y = 0; y < h; y++, dst += stride, src += src_stride) memcpy(dst, src, w * sizeof(uint16_t));
+    } else {
+        k->map_blend(dst, stride, src, src_stride, w, h, dsc->opa, mask, mask_stride);
+    }
+}
+
+static void ctx_init(lv_disp_drv_t* drv, lv_draw_ctx_t* draw_ctx) {
+    prev_ctx_init(drv, draw_ctx);
+    ((lv_draw_sw_ctx_t*)draw_ctx)->blend = kernel_blend;
+}
+
+void blend_kernels_attach(lv_disp_drv_t* drv) {
+    if (drv->draw_ctx_init == ctx_init) return;
+    if (drv->draw_ctx_size != sizeof(lv_draw_sw_ctx_t)) {
+        Serial.printf("[%s] not a software draw context, keeping LVGL's blend\n", TAG);
+        return;
+    }
+    prev_ctx_init = drv->draw_ctx_init;
+    drv->draw_ctx_init = ctx_init;
+    blend_kernels_use(DRAW_KERNELS ? blend_kernels_best() : nullptr);
+    Serial.printf("[%s] %s kernels\n", TAG, active ? active->name : "LVGL");
+}
+
+void blend_kernels_use(const BlendKernels* k) {
+    active = k;
+}
+
+const BlendKernels* blend_kernels_active() {
+    return active;
+}
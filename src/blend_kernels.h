@@ -0,0 +1,39 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// RGB565 fill and blend kernels for LVGL's software renderer. Pixels are
+// lv_color_t words as they sit in the draw buffer (byte-swapped with
+// LV_COLOR_16_SWAP). Every variant writes exactly the pixels of the scalar
+// reference, which reproduces lv_draw_sw_blend_basic() for normal blending:
+// lv_color_mix() (5-bit factor, rounded to nearest) for masked pixels and
+// images, the premultiplied mix for unmasked translucent fills, and LVGL's
+// choice of factor per masked pixel (the mask alone once opa is nearly
+// opaque).
+//
+// Variants: "scalar" (the reference), "swar" (32-bit words, what the
+// ESP32-S3 runs), "sse2" and "avx2" on x86 hosts, picked at runtime. A vector
+// unit such as the S3's PIE plugs in as one more table.
+
+struct BlendKernels {
+    const char* name;
+    // Strides in pixels (mask: bytes); mask may be nullptr for full coverage
+    void (*fill)(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color);
+    void (*fill_blend)(uint16_t* dst, int32_t stride, int32_t w, int32_t h, uint16_t color, uint8_t opa,
+                       const uint8_t* mask, int32_t mask_stride);
+    void (*map_blend)(uint16_t* dst, int32_t stride, const uint16_t* src, int32_t src_stride, int32_t w, int32_t h,
+                      uint8_t opa, const uint8_t* mask, int32_t mask_stride);
+};
+
+uint16_t blend_mix565(uint16_t fg, uint16_t bg, uint8_t mix);   // same as lv_color_mix()
+
+int blend_kernels_count();
+const BlendKernels* blend_kernels_get(int i);
+bool blend_kernels_supported(int i);   // false if this CPU lacks the instructions
+const BlendKernels* blend_kernels_best();
+
+// Route the software draw context's blends through the kernels. Call before
+// draw_parallel_attach() and lv_disp_drv_register().
+void blend_kernels_attach(lv_disp_drv_t* drv);
+void blend_kernels_use(const BlendKernels* k);   // nullptr: LVGL's own blend
+const BlendKernels* blend_kernels_active();
@@ -15,6 +15,62 @@
 
 // ----- Polling -----
 #define HA_POLL_INTERVAL_MS 30000
+#define HA_HISTORY_TIMEOUT_MS 15000   // one-time 24 h history backfill after boot
+#define HA_HISTORY_ATTEMPTS   4       // then give up; waits double from one poll interval
+
+// ----- Forecast -----
+#define HA_FORECAST_TYPE "daily"   // "daily" or "hourly" (service call only)
+#define HA_FORECAST_MAX  24        // entries kept from the forecast array
+
+// ----- Temperature history (temp_history.cpp, sparklines on the cards) -----
+#define TEMP_HISTORY_INTERVAL_S 300   // one sample slot per 5 min
+#define TEMP_HISTORY_SLOTS      288   // 24 h
+
+// ----- Long-term history (ts_store.cpp) -----
+// Append-only log of every reading in the "tsdb" flash partition
+// (partitions.csv, 896 KB: over 3 weeks of 3 sensors every 30 s)
+#define TS_STORE_SECTOR   4096
+#define TS_STORE_PAGE     256               // flash program unit: records are written a page at a time
+#define TS_STORE_SIM_FILE "tsdb.bin"        // simulator stand-in for the partition
+#define TS_STORE_SIM_SIZE (896 * 1024)
+
+// ----- Main loop -----
+#define EVENT_LOOP_MAX_SLEEP_MS    1000   // upper bound when no LVGL timer is due
+#define EVENT_LOOP_STATS_WINDOW_MS 5000   // wakeups/s and idle% averaging window
+#define EVENT_LOOP_LOG_MS          60000  // periodic stats log (0 = off)
+#define UI_QUEUE_CAPACITY          32     // pending UI commands from other tasks (power of two)
+
+// ----- Tasks (tasks.cpp) -----
+// UI task: LVGL, touch and display flush. Net task: WiFi, HTTP + JSON and
+// the flash log, on the core that already runs the WiFi/lwIP tasks.
+// Stack sizes in bytes (ESP-IDF), watched by mem_telemetry.
+#define UI_TASK_CORE        1
+#define UI_TASK_PRIORITY    2
+#define UI_TASK_STACK       8192
+#define NET_TASK_CORE       0
+#define NET_TASK_PRIORITY   1
+#define NET_TASK_STACK      12288
+#define CPU_STATS_CORES     2
+#define CPU_STATS_WINDOW_MS 5000   // per-core load averaging window
+
+// Two-core rendering (draw_parallel.cpp): large blends are split into row
+// bands, the lower one blended by a worker on the net core. Its priority is
+// above the net task's, since the UI task waits for it.
+#ifndef DRAW_PARALLEL
+#define DRAW_PARALLEL 1
+#endif
+#define DRAW_PARALLEL_MIN_PX 4096   // smaller blends cost less than the handoff
+#define DRAW_WORKER_CORE     NET_TASK_CORE
+#define DRAW_WORKER_PRIORITY 3
+#define DRAW_WORKER_STACK    4096
+
+// ----- Touch -----
+// GT911 INT line. -1 polls the controller over I2C every indev period; a
+// GPIO reads it only after an INT edge and pauses the indev timer when idle.
+#ifndef TOUCH_INT
+#define TOUCH_INT -1
+#endif
+#define TOUCH_RELEASE_MS 100   // re-read while pressed without INT, catches a missed release
 
 // ----- Display -----
 #define SCREEN_WIDTH  800
@@ -22,3 +78,60 @@
 #define LEFT_PANEL_W  220
 #define RIGHT_PANEL_W (SCREEN_WIDTH - LEFT_PANEL_W)
 #define STATUS_BAR_H  36
+
+// Layout mode: 1 = fixed rectangles from ui_layout.h (no flex or content
+// sizing at runtime), 0 = flex layout
+#ifndef UI_STATIC_LAYOUT
+#define UI_STATIC_LAYOUT 1
+#endif
+
+// Loading overlay opacity (0-255). Fully opaque lets LVGL redraw only the
+// spinner each frame; anything lower re-blends the whole dashboard under it.
+#ifndef UI_LOADING_OPA
+#define UI_LOADING_OPA 255
+#endif
+
+// Draw weather icons from pre-rendered images (icon_cache.cpp) instead of
+// blending font glyphs on every redraw
+#ifndef UI_ICON_CACHE
+#define UI_ICON_CACHE 1
+#endif
+
+// RGB565 fill/blend kernels for LVGL's software renderer (blend_kernels.h):
+// SSE2/AVX2 in the simulator, 32-bit SWAR on the device. 0 keeps LVGL's own.
+#ifndef DRAW_KERNELS
+#define DRAW_KERNELS 1
+#endif
+
+// Subset fonts generated at build time by tools/gen_fonts.py (ui_fonts.h).
+// Set from build_flags, since the build script and lv_conf.h read them too.
+#ifndef UI_SUBSET_FONTS
+#define UI_SUBSET_FONTS 0
+#endif
+#ifndef UI_SUBSET_FONTS_COMPRESS
+#define UI_SUBSET_FONTS_COMPRESS 0   // use the compressed variants
+#endif
+
+// ----- Diagnostics -----
+// Performance HUD (long-press the title, or "hud" over serial)
+#define PERF_HUD_UPDATE_MS 1000
+
+// Memory telemetry ring buffer (mem_telemetry.cpp, "mem" serial command)
+#define MEM_TELEMETRY_INTERVAL_MS 900000   // 15 min
+#define MEM_TELEMETRY_SAMPLES     96       // 24 h of history
+
+// Dirty-region instrumentation (redraw_stats.cpp), overridable from build_flags
+#ifndef REDRAW_STATS
+#define REDRAW_STATS 0          // attribute invalidated areas to tracked widgets
+#endif
+#ifndef REDRAW_HEATMAP
+#define REDRAW_HEATMAP 0        // start with the redraw heatmap overlay enabled
+#endif
+#define REDRAW_STATS_DUMP_MS 60000  // periodic top-sources dump (0 = off)
+
+// Callback profiler (profiler.cpp): times every lv_timer callback, flush and
+// indev read. Off by default; "prof on" over serial enables it at runtime.
+#ifndef PROFILER
+#define PROFILER 0
+#endif
+#define PROFILER_DUMP_MS 60000   // periodic table while enabled (0 = off)
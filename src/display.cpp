@@ -1,5 +1,13 @@
 #include "display.h"
 #include "config.h"
+#include "redraw_stats.h"
+#include "input_latency.h"
+#include "blend_kernels.h"
+#include "draw_parallel.h"
+#include "serial_console.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
 
 #define LGFX_USE_V1
 #include <LovyanGFX.hpp>
@@ -90,6 +98,19 @@ public:
     }
 };
 
+// LVGL's pixel layout, declared to LovyanGFX: with LV_COLOR_16_SWAP the
+// draw buffer holds swap565_t, the panel's own 16-bit format, so pushImage
+// copies it as is. A bare uint16_t* leaves the byte order to setSwapBytes()
+// and any mismatch with the panel costs a conversion of every pixel.
+#if LV_COLOR_16_SWAP
+typedef lgfx::swap565_t panel_pixel_t;
+#else
+typedef lgfx::rgb565_t panel_pixel_t;
+#endif
+static_assert(sizeof(panel_pixel_t) == sizeof(lv_color_t), "LVGL and LovyanGFX pixels differ in size");
+
+static const char* TAG = "DISP";
+
 static LGFX tft;
 static lv_disp_drv_t disp_drv;
 static lv_disp_draw_buf_t draw_buf;
@@ -99,10 +120,67 @@ static lv_disp_t* s_disp = nullptr;
 static void lvgl_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
     uint32_t w = area->x2 - area->x1 + 1;
     uint32_t h = area->y2 - area->y1 + 1;
-    tft.pushImage(area->x1, area->y1, w, h, (uint16_t*)&color_p->full);
+    redraw_stats_on_flush(area, color_p);
+    tft.pushImage(area->x1, area->y1, w, h, (const panel_pixel_t*)color_p);
     lv_disp_flush_ready(drv);
 }
 
+// ----- Flush microbenchmark ("flush [reps]") -----
+// Pushes one draw buffer to the top band as LVGL's format, as rgb565_t
+// (forces a swap per pixel), as a bare uint16_t* (the old flush) and a
+// plain PSRAM memcpy of the same bytes for scale. Runs between refreshes on
+// the UI task, so the draw buffer is free; the screen is redrawn after.
+static void cmd_flush(const char* args) {
+    int reps = atoi(args);
+    if (reps <= 0) reps = 20;
+    const int32_t w = SCREEN_WIDTH, h = SCREEN_HEIGHT / 10;
+    const size_t bytes = w * h * sizeof(lv_color_t);
+
+    // Byte order check: pure red must read back as RGB565 0xF800
+    lv_color_t red = lv_color_hex(0xFF0000);
+    for (int32_t i = 0; i < w * h; i++) buf1[i] = red;
+    tft.pushImage(0, 0, w, h, (const panel_pixel_t*)buf1);
+    lgfx::rgb565_t px;
+    tft.readRect(0, 0, 1, 1, &px);
+    uint16_t back = px.raw;
+    Serial.printf("[%s] red reads back as 0x%04X: %s\n", TAG, back,
+                  back == 0xF800 ? "byte order ok" : "WRONG byte order");
+
+    void* scratch = ps_malloc(bytes);
+    uint32_t t0 = micros();
+    for (int r = 0; r < reps && scratch; r++) memcpy(scratch, buf1, bytes);
+    uint32_t copy_us = micros() - t0;
+    free(scratch);
+
+    uint32_t us[3];
+    for (int v = 0; v < 3; v++) {
+        t0 = micros();
+        for (int r = 0; r < reps; r++) {
+            if (v == 0) tft.pushImage(0, 0, w, h, (const panel_pixel_t*)buf1);
+            else if (v == 1) tft.pushImage(0, 0, w, h, (const lgfx::rgb565_t*)buf1);
+            else tft.pushImage(0, 0, w, h, (const uint16_t*)buf1);
+        }
+        us[v] = micros() - t0;
+    }
+
+    static const char* NAMES[] = {"LVGL format (flush)", "rgb565_t (converted)", "uint16_t* (old flush)"};
+    Serial.printf("[%s] %ldx%ld px, %d reps\n", TAG, (long)w, (long)h, reps);
+    if (copy_us) {
+        Serial.printf("[%s]   %-22s %7.0f us  %5.1f MB/s\n", TAG, "memcpy PSRAM", (double)copy_us / reps,
+                      (double)bytes * reps / copy_us);
+    }
+    for (int v = 0; v < 3; v++) {
+        Serial.printf("[%s]   %-22s %7.0f us  %5.1f MB/s\n", TAG, NAMES[v], (double)us[v] / reps,
+                      us[v] ? (double)bytes * reps / us[v] : 0.0);
+    }
+    lv_obj_invalidate(lv_scr_act());
+    lv_obj_invalidate(lv_layer_top());
+}
+
+void display_bench_init() {
+    serial_console_add("flush", "display flush timing and byte order: flush [reps]", cmd_flush);
+}
+
 void display_init() {
     tft.begin();
     tft.setRotation(0);
@@ -124,6 +202,10 @@ void display_init() {
     disp_drv.ver_res  = SCREEN_HEIGHT;
     disp_drv.flush_cb = lvgl_flush_cb;
     disp_drv.draw_buf = &draw_buf;
+    redraw_stats_attach(&disp_drv);
+    input_latency_attach_disp(&disp_drv);
+    blend_kernels_attach(&disp_drv);
+    draw_parallel_attach(&disp_drv);
     s_disp = lv_disp_drv_register(&disp_drv);
 
     // Set dark theme
@@ -3,3 +3,4 @@
 
 void display_init();
 lv_disp_t* display_get();
+void display_bench_init();   // "flush" serial command
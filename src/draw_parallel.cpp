@@ -0,0 +1,198 @@
+#include "draw_parallel.h"
+#include "config.h"
+#include "serial_console.h"
+#include "tasks.h"
+#include <Arduino.h>
+#include <string.h>
+
+#ifdef SIMULATOR
+#include <condition_variable>
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+static const char* TAG = "PAR";
+
+typedef void (*blend_fn)(lv_draw_ctx_t* draw_ctx, const lv_draw_sw_blend_dsc_t* dsc);
+
+static void (*prev_ctx_init)(lv_disp_drv_t*, lv_draw_ctx_t*) = nullptr;
+static blend_fn inner_blend = nullptr;
+static bool enabled = false;
+static bool worker_started = false;
+static DrawParallelStats stats = {};
+
+// The worker's band: a copy of the draw context clipped to the lower rows.
+// Written by the UI task before the kick, read by the worker until it
+// signals done.
+static struct {
+    lv_draw_sw_ctx_t ctx;
+    lv_area_t clip;
+    const lv_draw_sw_blend_dsc_t* dsc;
+} job;
+
+// ----- Kick / done handshake -----
+#ifdef SIMULATOR
+// Never freed: the worker thread is still waiting on it when main() returns
+struct Handshake {
+    std::mutex m;
+    std::condition_variable cv;
+    uint32_t kicked = 0, finished = 0;
+};
+static Handshake* hs = nullptr;
+
+static void kick_worker() {
+    std::lock_guard<std::mutex> lock(hs->m);
+    hs->kicked++;
+    hs->cv.notify_all();
+}
+
+static void wait_worker() {
+    std::unique_lock<std::mutex> lock(hs->m);
+    hs->cv.wait(lock, [] { return hs->finished == hs->kicked; });
+}
+
+static void wait_kick() {
+    std::unique_lock<std::mutex> lock(hs->m);
+    hs->cv.wait(lock, [] { return hs->kicked != hs->finished; });
+}
+
+static void signal_done() {
+    std::lock_guard<std::mutex> lock(hs->m);
+    hs->finished++;
+    hs->cv.notify_all();
+}
+#else
+static TaskHandle_t worker = nullptr;
+static SemaphoreHandle_t band_done = nullptr;   // not the UI task's notification: the event loop owns that
+
+static void kick_worker() { xTaskNotifyGive(worker); }
+static void wait_worker() { xSemaphoreTake(band_done, portMAX_DELAY); }
+static void wait_kick() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+static void signal_done() { xSemaphoreGive(band_done); }
+#endif
+
+static void worker_task(void* arg) {
+    (void)arg;
+    for (;;) {
+        wait_kick();
+        uint32_t t0 = micros();
+        inner_blend(&job.ctx.base_draw, job.dsc);
+        cpu_stats_add_busy(DRAW_WORKER_CORE, micros() - t0);
+        signal_done();
+    }
+}
+
+static bool start_worker() {
+#ifndef SIMULATOR
+    band_done = xSemaphoreCreateBinary();
+    if (!band_done) return false;
+    worker = (TaskHandle_t)task_spawn("draw", worker_task, nullptr, DRAW_WORKER_CORE, DRAW_WORKER_PRIORITY,
+                                      DRAW_WORKER_STACK);
+    return worker != nullptr;
+#else
+    hs = new Handshake();
+    task_spawn("draw", worker_task, nullptr, DRAW_WORKER_CORE, DRAW_WORKER_PRIORITY, DRAW_WORKER_STACK);
+    return true;
+#endif
+}
+
+// ----- Blend -----
+static void parallel_blend(lv_draw_ctx_t* draw_ctx, const lv_draw_sw_blend_dsc_t* dsc) {
+    lv_area_t area;
+    if (!_lv_area_intersect(&area, dsc->blend_area, draw_ctx->clip_area)) return;
+    stats.blends++;
+    uint32_t px = lv_area_get_size(&area);
+    // LVGL's unmasked translucent fill caches the last blended pixel, seeded
+    // with the color mixed over black: split, the lower band would start
+    // with a fresh cache and black pixels at its top could come out
+    // differently. Keep those fills on one band.
+    bool unmasked = !dsc->mask_buf || dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER;
+    bool cached_fill = !dsc->src_buf && unmasked && dsc->opa < LV_OPA_MAX;
+    if (!enabled || cached_fill || px < DRAW_PARALLEL_MIN_PX || lv_area_get_height(&area) < 2) {
+        stats.inline_px += px;
+        inner_blend(draw_ctx, dsc);
+        return;
+    }
+
+    // Same dsc for both bands: the blend offsets src_buf and mask_buf from
+    // the narrowed clip area itself
+    lv_coord_t mid = area.y1 + lv_area_get_height(&area) / 2;
+    job.ctx = *(lv_draw_sw_ctx_t*)draw_ctx;
+    job.clip = area;
+    job.clip.y1 = mid;
+    job.ctx.base_draw.clip_area = &job.clip;
+    job.dsc = dsc;
+    kick_worker();
+
+    lv_draw_sw_ctx_t own = *(lv_draw_sw_ctx_t*)draw_ctx;
+    lv_area_t top = area;
+    top.y2 = mid - 1;
+    own.base_draw.clip_area = &top;
+    inner_blend(&own.base_draw, dsc);
+
+    uint32_t t0 = micros();
+    wait_worker();
+    uint32_t waited = micros() - t0;
+    stats.wait_us += waited;
+    cpu_stats_add_wait(UI_TASK_CORE, waited);   // blocked, not rendering
+    stats.split++;
+    stats.split_px += px;
+}
+
+static void ctx_init(lv_disp_drv_t* drv, lv_draw_ctx_t* draw_ctx) {
+    prev_ctx_init(drv, draw_ctx);
+    lv_draw_sw_ctx_t* sw = (lv_draw_sw_ctx_t*)draw_ctx;
+    inner_blend = sw->blend;
+    sw->blend = parallel_blend;
+}
+
+void draw_parallel_attach(lv_disp_drv_t* drv) {
+    if (drv->draw_ctx_init == ctx_init) return;
+    if (drv->draw_ctx_size != sizeof(lv_draw_sw_ctx_t)) {
+        Serial.printf("[%s] not a software draw context, rendering stays on one core\n", TAG);
+        return;
+    }
+    prev_ctx_init = drv->draw_ctx_init;
+    drv->draw_ctx_init = ctx_init;
+    draw_parallel_set_enabled(DRAW_PARALLEL);
+}
+
+void draw_parallel_set_enabled(bool on) {
+    if (on && !worker_started) {
+        worker_started = start_worker();
+        if (!worker_started) Serial.printf("[%s] cannot start the draw worker\n", TAG);
+    }
+    enabled = on && worker_started;
+}
+
+bool draw_parallel_enabled() {
+    return enabled;
+}
+
+void draw_parallel_get_stats(DrawParallelStats& out) {
+    out = stats;
+}
+
+void draw_parallel_reset_stats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+static void cmd_par(const char* args) {
+    if (strcmp(args, "on") == 0) draw_parallel_set_enabled(true);
+    else if (strcmp(args, "off") == 0) draw_parallel_set_enabled(false);
+    else if (strcmp(args, "reset") == 0) draw_parallel_reset_stats();
+
+    uint64_t total_px = stats.split_px + stats.inline_px;
+    Serial.printf("[%s] %s, worker on core %d, bands from %d px\n", TAG, enabled ? "enabled" : "disabled",
+                  DRAW_WORKER_CORE, DRAW_PARALLEL_MIN_PX);
+    Serial.printf("[%s] %lu blends, %lu split (%.1f%% of %.1f Mpx), waited %.1f ms for the worker\n", TAG,
+                  (unsigned long)stats.blends, (unsigned long)stats.split,
+                  total_px ? 100.0 * stats.split_px / total_px : 0.0, total_px / 1e6, stats.wait_us / 1000.0);
+}
+
+void draw_parallel_init() {
+    serial_console_add("par", "two-core rendering: par [on|off|reset]", cmd_par);
+}
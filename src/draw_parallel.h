@@ -0,0 +1,30 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// Two-core software rendering. LVGL 8 walks the object tree on the UI task
+// only (styles, masks and the image cache are not thread-safe), but every
+// pixel it produces goes through the draw context's blend callback, which is
+// plain buffer arithmetic. Blends of at least DRAW_PARALLEL_MIN_PX are cut
+// into two row bands: a worker task on the other core blends the lower one
+// while the UI task blends the upper one. The call returns when both are
+// done, so blends land in the draw buffer in LVGL's order. Unmasked
+// translucent fills stay on one band (their result cache carries across
+// rows), so the flush gets exactly the pixels a serial render would.
+
+struct DrawParallelStats {
+    uint32_t blends;      // blend calls seen
+    uint32_t split;       // of those, run as two bands
+    uint64_t split_px;
+    uint64_t inline_px;   // below the threshold or disabled: UI task only
+    uint64_t wait_us;     // UI task waiting for the worker's band
+};
+
+// Wrap the software draw context; call before lv_disp_drv_register()
+void draw_parallel_attach(lv_disp_drv_t* drv);
+
+void draw_parallel_init();   // "par" serial command
+void draw_parallel_set_enabled(bool on);   // starts the worker on first use
+bool draw_parallel_enabled();
+void draw_parallel_get_stats(DrawParallelStats& out);
+void draw_parallel_reset_stats();
@@ -0,0 +1,128 @@
+#include "event_loop.h"
+#include "config.h"
+#include "tasks.h"
+#include <Arduino.h>
+#include <lvgl.h>
+
+#ifdef SIMULATOR
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+static const char* TAG = "LOOP";
+
+#ifdef SIMULATOR
+static std::mutex              wake_mutex;
+static std::condition_variable wake_cv;
+static bool                    wake_pending = false;
+#else
+static TaskHandle_t loop_task = nullptr;
+#endif
+
+// Current stats window
+static uint32_t window_start_us = 0;
+static uint32_t window_wakeups  = 0;
+static uint64_t window_sleep_us = 0;
+
+static EventLoopStats stats = {};
+static uint32_t last_log_ms = 0;
+
+#define EVENT_LOOP_MAX_HOOKS 6
+static void (*wake_hooks[EVENT_LOOP_MAX_HOOKS])();
+static uint8_t wake_hook_count = 0;
+
+// Returns true if woken before the timeout
+static bool sleep_ms(uint32_t ms) {
+#ifdef SIMULATOR
+    std::unique_lock<std::mutex> lock(wake_mutex);
+    bool woken = wake_cv.wait_for(lock, std::chrono::milliseconds(ms), [] { return wake_pending; });
+    wake_pending = false;
+    return woken;
+#else
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ms)) > 0;
+#endif
+}
+
+static void close_window(uint32_t now_us) {
+    uint32_t elapsed = now_us - window_start_us;
+    if (elapsed < EVENT_LOOP_STATS_WINDOW_MS * 1000UL) return;
+
+    stats.wakeups_per_s = window_wakeups * 1e6f / elapsed;
+    stats.idle_pct      = 100.0f * window_sleep_us / elapsed;
+    window_start_us = now_us;
+    window_wakeups  = 0;
+    window_sleep_us = 0;
+
+#if EVENT_LOOP_LOG_MS > 0
+    uint32_t now_ms = millis();
+    if (now_ms - last_log_ms >= EVENT_LOOP_LOG_MS) {
+        last_log_ms = now_ms;
+        Serial.printf("[%s] %.1f wakeups/s, %.1f%% idle\n", TAG, stats.wakeups_per_s, stats.idle_pct);
+    }
+#else
+    (void)last_log_ms;
+    (void)TAG;
+#endif
+}
+
+void event_loop_init() {
+#ifndef SIMULATOR
+    loop_task = xTaskGetCurrentTaskHandle();
+#endif
+    window_start_us = micros();
+    last_log_ms = millis();
+}
+
+void event_loop_run_once() {
+    uint32_t start_us = micros();
+    for (uint8_t i = 0; i < wake_hook_count; i++) wake_hooks[i]();
+
+    uint32_t next_ms = lv_timer_handler();
+    if (next_ms > EVENT_LOOP_MAX_SLEEP_MS) next_ms = EVENT_LOOP_MAX_SLEEP_MS;  // also LV_NO_TIMER_READY
+
+    uint32_t t0 = micros();
+    cpu_stats_add_busy(UI_TASK_CORE, t0 - start_us);
+    if (next_ms > 0) {
+        if (sleep_ms(next_ms)) stats.early_wakeups++;
+        window_sleep_us += micros() - t0;
+    }
+
+    window_wakeups++;
+    stats.wakeups++;
+    close_window(micros());
+}
+
+void event_loop_wake() {
+#ifdef SIMULATOR
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+        wake_pending = true;
+    }
+    wake_cv.notify_one();
+#else
+    if (loop_task) xTaskNotifyGive(loop_task);
+#endif
+}
+
+void IRAM_ATTR event_loop_wake_from_isr() {
+#ifdef SIMULATOR
+    event_loop_wake();
+#else
+    if (!loop_task) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(loop_task, &woken);
+    portYIELD_FROM_ISR(woken);
+#endif
+}
+
+void event_loop_get_stats(EventLoopStats& out) {
+    out = stats;
+}
+
+void event_loop_on_wake(void (*cb)()) {
+    if (wake_hook_count < EVENT_LOOP_MAX_HOOKS) wake_hooks[wake_hook_count++] = cb;
+}
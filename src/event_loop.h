@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+
+// Main loop pacing. Each iteration runs lv_timer_handler() and then sleeps
+// until the next LVGL timer is due, or until another task / ISR calls
+// event_loop_wake() (touch, network), instead of polling every 5 ms.
+
+struct EventLoopStats {
+    float    wakeups_per_s;   // loop iterations per second over the last window
+    float    idle_pct;        // share of the window spent sleeping
+    uint32_t wakeups;         // total since start
+    uint32_t early_wakeups;   // total woken by event_loop_wake() before the timeout
+};
+
+void event_loop_init();          // call from the task that runs the loop
+void event_loop_run_once();
+void event_loop_wake();          // from any task
+void event_loop_wake_from_isr(); // from an ISR (same as event_loop_wake in the simulator)
+void event_loop_get_stats(EventLoopStats& out);
+
+// Run cb on the loop task at the start of every iteration, before LVGL
+// timers. For work an ISR can only flag, e.g. resuming a paused lv_timer.
+void event_loop_on_wake(void (*cb)());
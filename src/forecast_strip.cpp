@@ -0,0 +1,295 @@
+#include "forecast_strip.h"
+#include "weather_icons.h"
+#include "ui_fonts.h"
+#include "icon_cache.h"
+#include <string.h>
+
+#define FC_CARD_W     160
+#define FC_GAP        12     // minimum gap between cards
+#define FC_PAD        12
+#define FC_RADIUS     8
+#define FC_SLOT_COUNT 6      // cards fully or partially visible at once, plus one spare
+
+#define FC_DAY_FONT   UI_FONT_16
+#define FC_TEXT_FONT  UI_FONT_14
+#define FC_ICON_FONT  UI_FONT_WEATHER_24
+#define FC_ICON_COLOR lv_color_hex(0xFBBF24)
+#define FC_HIGH_COLOR lv_color_hex(0xF97316)
+#define FC_LOW_COLOR  lv_color_hex(0x3B82F6)
+
+// Formatted text of one on-screen card; rebound to another entry when recycled
+typedef struct {
+    int16_t             index;      // forecast entry shown by this slot, -1 = free
+    const char*         icon;
+    const lv_img_dsc_t* icon_img;   // pre-rendered icon, nullptr = draw the glyph
+    const char*         label;
+    char                day[8];
+    char                high[2][16];   // [fahrenheit], both formatted when bound
+    char                low[2][16];
+} fc_slot_t;
+
+typedef struct {
+    lv_obj_t             obj;
+    const HAForecastDay* days;
+    uint16_t             count;
+    forecast_temp_fmt_cb fmt;
+    bool                 fahrenheit;
+    lv_coord_t           temp_y1;   // high/low rows, relative to the content top (0/0 = not drawn yet)
+    lv_coord_t           temp_y2;
+    fc_slot_t            slots[FC_SLOT_COUNT];
+    lv_color_t           card_color;
+    lv_color_t           text_color;
+    lv_color_t           dim_color;
+} forecast_strip_t;
+
+static lv_obj_class_t forecast_strip_class;
+
+// ----- Geometry -----
+// Few entries are spread evenly across the strip (like the old flex row);
+// more than fit are packed with FC_GAP and scroll.
+static void strip_layout(const forecast_strip_t* s, lv_coord_t* start, lv_coord_t* pitch) {
+    lv_coord_t w = lv_obj_get_content_width(&s->obj);
+    lv_coord_t n = s->count;
+    if (n > 0 && n * FC_CARD_W + (n + 1) * FC_GAP <= w) {
+        lv_coord_t gap = (w - n * FC_CARD_W) / (n + 1);
+        *start = gap;
+        *pitch = FC_CARD_W + gap;
+    } else {
+        *start = 0;
+        *pitch = FC_CARD_W + FC_GAP;
+    }
+}
+
+static lv_coord_t content_width(const forecast_strip_t* s) {
+    if (s->count == 0) return 0;
+    return s->count * (FC_CARD_W + FC_GAP) - FC_GAP;
+}
+
+// ----- Slot pool -----
+static void slot_bind(forecast_strip_t* s, fc_slot_t* slot, int16_t index) {
+    const HAForecastDay& d = s->days[index];
+    slot->index = index;
+
+    if (!d.valid) {
+        slot->icon     = ICON_WEATHER_CLOUDY;
+        slot->icon_img = icon_cache_get(slot->icon, FC_ICON_FONT, FC_ICON_COLOR);
+        slot->label    = "--";
+        strcpy(slot->day, "---");
+        for (int f = 0; f < 2; f++) {
+            strcpy(slot->high[f], "H: --");
+            strcpy(slot->low[f], "L: --");
+        }
+        return;
+    }
+
+    WeatherDisplay wd = weather_get_display(d.condition.c_str());
+    slot->icon     = wd.icon;
+    slot->icon_img = icon_cache_get(slot->icon, FC_ICON_FONT, FC_ICON_COLOR);
+    slot->label    = wd.label;
+    strncpy(slot->day, d.day_name.c_str(), sizeof(slot->day) - 1);
+    slot->day[sizeof(slot->day) - 1] = '\0';
+
+    char t[12];
+    for (int f = 0; f < 2; f++) {
+        s->fmt(d.temp_high, f, t, sizeof(t));
+        snprintf(slot->high[f], sizeof(slot->high[f]), "H: %s", t);
+        // Blank row, not "L: 0", when there is no low (hourly); keeps the card layout
+        if (!d.has_low) {
+            slot->low[f][0] = '\0';
+            continue;
+        }
+        s->fmt(d.temp_low, f, t, sizeof(t));
+        snprintf(slot->low[f], sizeof(slot->low[f]), "L: %s", t);
+    }
+}
+
+// Slot already showing `index`, else recycle one whose entry scrolled out of view
+static fc_slot_t* slot_for(forecast_strip_t* s, int16_t index, int16_t first, int16_t last) {
+    fc_slot_t* spare = nullptr;
+    for (int i = 0; i < FC_SLOT_COUNT; i++) {
+        fc_slot_t* slot = &s->slots[i];
+        if (slot->index == index) return slot;
+        if (!spare && (slot->index < first || slot->index > last)) spare = slot;
+    }
+    if (!spare) return nullptr;
+    slot_bind(s, spare, index);
+    return spare;
+}
+
+static void slots_release(forecast_strip_t* s) {
+    for (int i = 0; i < FC_SLOT_COUNT; i++) s->slots[i].index = -1;
+}
+
+// ----- Drawing -----
+static void draw_row(lv_draw_ctx_t* draw_ctx, lv_draw_label_dsc_t* dsc, lv_area_t* row,
+                     const lv_font_t* font, lv_color_t color, const char* txt, lv_coord_t gap_after) {
+    dsc->font  = font;
+    dsc->color = color;
+    row->y2 = row->y1 + lv_font_get_line_height(font) - 1;
+    lv_draw_label(draw_ctx, dsc, row, txt, nullptr);
+    row->y1 = row->y2 + 1 + gap_after;
+}
+
+static void draw_icon_row(lv_draw_ctx_t* draw_ctx, lv_area_t* row, const lv_img_dsc_t* img,
+                          lv_coord_t gap_after) {
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+
+    lv_area_t a;
+    a.x1 = row->x1 + (lv_area_get_width(row) - img->header.w) / 2;
+    a.x2 = a.x1 + img->header.w - 1;
+    a.y1 = row->y1;
+    a.y2 = a.y1 + img->header.h - 1;
+    lv_draw_img(draw_ctx, &img_dsc, &a, img);
+    row->y1 = a.y2 + 1 + gap_after;
+}
+
+static void draw_card(forecast_strip_t* s, lv_draw_ctx_t* draw_ctx, const fc_slot_t* slot,
+                      const lv_area_t* card) {
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.radius   = FC_RADIUS;
+    rect_dsc.bg_color = s->card_color;
+    rect_dsc.bg_opa   = LV_OPA_COVER;
+    lv_draw_rect(draw_ctx, &rect_dsc, card);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.align = LV_TEXT_ALIGN_CENTER;
+
+    lv_area_t row = *card;
+    row.x1 += FC_PAD;
+    row.x2 -= FC_PAD;
+    row.y1 += FC_PAD;
+    draw_row(draw_ctx, &label_dsc, &row, FC_DAY_FONT,  s->text_color, slot->day,   4);
+    if (slot->icon_img) {
+        draw_icon_row(draw_ctx, &row, slot->icon_img, 4);
+    } else {
+        draw_row(draw_ctx, &label_dsc, &row, FC_ICON_FONT, FC_ICON_COLOR, slot->icon, 4);
+    }
+    draw_row(draw_ctx, &label_dsc, &row, FC_TEXT_FONT, s->dim_color,  slot->label, 2);
+    lv_coord_t temp_y1 = row.y1 - card->y1;
+    draw_row(draw_ctx, &label_dsc, &row, FC_TEXT_FONT, FC_HIGH_COLOR, slot->high[s->fahrenheit], 0);
+    draw_row(draw_ctx, &label_dsc, &row, FC_TEXT_FONT, FC_LOW_COLOR,  slot->low[s->fahrenheit],  0);
+    s->temp_y1 = temp_y1;
+    s->temp_y2 = row.y1 - 1 - card->y1;
+}
+
+static void draw_strip(forecast_strip_t* s, lv_draw_ctx_t* draw_ctx) {
+    if (!s->days || s->count == 0) return;
+
+    lv_coord_t start, pitch;
+    strip_layout(s, &start, &pitch);
+
+    lv_area_t content;
+    lv_obj_get_content_coords(&s->obj, &content);
+    lv_coord_t scroll_x = lv_obj_get_scroll_x(&s->obj);
+    lv_coord_t w = lv_area_get_width(&content);
+
+    int16_t first = (scroll_x - start) / pitch;
+    int16_t last  = (scroll_x + w - start) / pitch;
+    if (first < 0) first = 0;
+    if (last > s->count - 1) last = s->count - 1;
+
+    for (int16_t i = first; i <= last; i++) {
+        lv_area_t card;
+        card.x1 = content.x1 + start + i * pitch - scroll_x;
+        card.x2 = card.x1 + FC_CARD_W - 1;
+        card.y1 = content.y1;
+        card.y2 = content.y1 + FORECAST_STRIP_H - 1;
+
+        lv_area_t visible;
+        if (!_lv_area_intersect(&visible, &card, draw_ctx->clip_area)) continue;
+
+        const fc_slot_t* slot = slot_for(s, i, first, last);
+        if (slot) draw_card(s, draw_ctx, slot, &card);
+    }
+}
+
+// ----- Class callbacks -----
+static void forecast_strip_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj) {
+    (void)class_p;
+    forecast_strip_t* s = (forecast_strip_t*)obj;
+    s->days       = nullptr;
+    s->count      = 0;
+    s->fmt        = nullptr;
+    s->fahrenheit = false;
+    s->temp_y1    = 0;
+    s->temp_y2    = 0;
+    s->card_color = lv_color_hex(0x21262D);
+    s->text_color = lv_color_hex(0xFFFFFF);
+    s->dim_color  = lv_color_hex(0x8B949E);
+    slots_release(s);
+
+    // Native LVGL scrolling (momentum + elastic) over the self-reported content width
+    lv_obj_set_scroll_dir(obj, LV_DIR_HOR);
+    lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
+}
+
+static void forecast_strip_event(const lv_obj_class_t* class_p, lv_event_t* e) {
+    (void)class_p;
+    if (lv_obj_event_base(&forecast_strip_class, e) != LV_RES_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    forecast_strip_t* s = (forecast_strip_t*)lv_event_get_target(e);
+
+    if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t* p = (lv_point_t*)lv_event_get_param(e);
+        p->x = LV_MAX(p->x, content_width(s));
+    } else if (code == LV_EVENT_DRAW_MAIN) {
+        draw_strip(s, lv_event_get_draw_ctx(e));
+    }
+}
+
+// ----- Public API -----
+lv_obj_t* forecast_strip_create(lv_obj_t* parent, forecast_temp_fmt_cb fmt) {
+    if (!forecast_strip_class.base_class) {
+        forecast_strip_class.base_class     = &lv_obj_class;
+        forecast_strip_class.constructor_cb = forecast_strip_constructor;
+        forecast_strip_class.event_cb       = forecast_strip_event;
+        forecast_strip_class.width_def      = LV_PCT(100);
+        forecast_strip_class.height_def     = FORECAST_STRIP_H;
+        forecast_strip_class.instance_size  = sizeof(forecast_strip_t);
+    }
+
+    lv_obj_t* obj = lv_obj_class_create_obj(&forecast_strip_class, parent);
+    lv_obj_class_init_obj(obj);
+    ((forecast_strip_t*)obj)->fmt = fmt;
+    return obj;
+}
+
+void forecast_strip_set_data(lv_obj_t* obj, const HAForecastDay* days, uint16_t count) {
+    forecast_strip_t* s = (forecast_strip_t*)obj;
+    bool resized = count != s->count;
+    s->days  = days;
+    s->count = count;
+    slots_release(s);
+
+    if (resized) lv_obj_scroll_to_x(obj, 0, LV_ANIM_OFF);
+    lv_obj_invalidate(obj);
+}
+
+void forecast_strip_set_unit(lv_obj_t* obj, bool fahrenheit) {
+    forecast_strip_t* s = (forecast_strip_t*)obj;
+    if (s->fahrenheit == fahrenheit) return;
+    s->fahrenheit = fahrenheit;
+    if (s->temp_y2 <= s->temp_y1) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    // Slots already hold both units: redraw only the band of high/low rows
+    lv_area_t band;
+    lv_obj_get_content_coords(obj, &band);
+    band.y2 = band.y1 + s->temp_y2;
+    band.y1 += s->temp_y1;
+    lv_obj_invalidate_area(obj, &band);
+}
+
+void forecast_strip_set_colors(lv_obj_t* obj, lv_color_t card, lv_color_t text, lv_color_t dim) {
+    forecast_strip_t* s = (forecast_strip_t*)obj;
+    s->card_color = card;
+    s->text_color = text;
+    s->dim_color  = dim;
+    lv_obj_invalidate(obj);
+}
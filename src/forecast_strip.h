@@ -0,0 +1,19 @@
+#pragma once
+#include <lvgl.h>
+#include "ha_client.h"
+
+// Horizontally scrollable forecast strip. Draws every visible card from one
+// object; a small pool of slots caches the formatted text of the cards on
+// screen and is recycled while scrolling, so memory does not grow with the
+// number of entries.
+#define FORECAST_STRIP_H 128
+
+// Formats a Celsius temperature for display in either unit (unit handling
+// stays in ui.cpp). Cards format both when bound, so a unit switch is a redraw.
+typedef void (*forecast_temp_fmt_cb)(float celsius, bool fahrenheit, char* buf, size_t len);
+
+lv_obj_t* forecast_strip_create(lv_obj_t* parent, forecast_temp_fmt_cb fmt);
+// `days` must stay valid until the next call (ui.cpp passes last_data.forecast)
+void forecast_strip_set_data(lv_obj_t* obj, const HAForecastDay* days, uint16_t count);
+void forecast_strip_set_unit(lv_obj_t* obj, bool fahrenheit);
+void forecast_strip_set_colors(lv_obj_t* obj, lv_color_t card, lv_color_t text, lv_color_t dim);
@@ -1,5 +1,6 @@
 #include "ha_client.h"
 #include "config.h"
+#include "history_backfill.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
@@ -7,6 +8,7 @@
 static const char* TAG = "HA";
 
 static const char* DAY_NAMES[] = {"Sun","Mon","Tue","Wed","Thu","Fri","Sat"};
+static HAFetchTimings fetch_timings = {};
 
 void ha_client_init() {
     // Nothing to initialize
@@ -124,19 +126,26 @@ static void fetch_current_weather(HACurrentWeather& weather) {
     Serial.printf("[%s] Weather: %s %.1f°C\n", TAG, weather.condition.c_str(), weather.temperature);
 }
 
-static void parse_forecast_array(JsonArray fc, HAForecastDay forecast[3]) {
-    for (int i = 0; i < 3 && i < (int)fc.size(); i++) {
+static void parse_forecast_array(JsonArray fc, HAForecastDay* forecast, uint8_t& count) {
+    count = 0;
+    for (int i = 0; i < HA_FORECAST_MAX && i < (int)fc.size(); i++) {
         JsonObject day = fc[i];
         forecast[i].condition = day["condition"].as<String>();
         forecast[i].temp_high = day["temperature"] | 0.0f;
         forecast[i].temp_low  = day["templow"] | 0.0f;
+        forecast[i].has_low   = !day["templow"].isNull();
 
-        // Parse day name from datetime string "2024-01-15T..."
+        // Parse day name (or hour) from datetime string "2024-01-15T14:00..."
         const char* dt = day["datetime"];
         if (dt) {
             struct tm tm_val = {};
-            int y, m, d;
-            if (sscanf(dt, "%d-%d-%d", &y, &m, &d) == 3) {
+            int y, m, d, hh = 0;
+            int n = sscanf(dt, "%d-%d-%dT%d", &y, &m, &d, &hh);
+            if (n >= 3 && strcmp(HA_FORECAST_TYPE, "hourly") == 0) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "%02d:00", hh);
+                forecast[i].day_name = buf;
+            } else if (n >= 3) {
                 tm_val.tm_year = y - 1900;
                 tm_val.tm_mon  = m - 1;
                 tm_val.tm_mday = d;
@@ -150,25 +159,28 @@ static void parse_forecast_array(JsonArray fc, HAForecastDay forecast[3]) {
         }
 
         forecast[i].valid = true;
-        Serial.printf("[%s] Forecast %s: %s H:%.0f L:%.0f\n",
-                      TAG, forecast[i].day_name.c_str(),
-                      forecast[i].condition.c_str(),
-                      forecast[i].temp_high, forecast[i].temp_low);
+        count = i + 1;
+        Serial.printf("[%s] Forecast %s: %s H:%.0f", TAG, forecast[i].day_name.c_str(),
+                      forecast[i].condition.c_str(), forecast[i].temp_high);
+        if (forecast[i].has_low) Serial.printf(" L:%.0f", forecast[i].temp_low);
+        Serial.println();
     }
 }
 
-static void fetch_forecast(HAForecastDay forecast[3]) {
-    for (int i = 0; i < 3; i++) forecast[i].valid = false;
+static void fetch_forecast(HAForecastDay* forecast, uint8_t& count) {
+    for (int i = 0; i < HA_FORECAST_MAX; i++) forecast[i].valid = false;
+    count = 0;
 
     // Method 1: Try reading forecast from weather entity attributes (older HA / some integrations)
-    {
+    // Attribute forecasts are daily, so hourly mode goes straight to the service call
+    if (strcmp(HA_FORECAST_TYPE, "daily") == 0) {
         String url = String(HA_BASE_URL) + "/api/states/" + HA_ENTITY_WEATHER;
         JsonDocument doc;
         if (ha_get(url, doc)) {
             JsonArray fc = doc["attributes"]["forecast"];
             if (!fc.isNull() && fc.size() > 0) {
                 Serial.printf("[%s] Forecast from entity attributes\n", TAG);
-                parse_forecast_array(fc, forecast);
+                parse_forecast_array(fc, forecast, count);
                 return;
             }
         }
@@ -177,7 +189,7 @@ static void fetch_forecast(HAForecastDay forecast[3]) {
     // Method 2: Try service call with return_response (HA 2024.7+)
     {
         String url = String(HA_BASE_URL) + "/api/services/weather/get_forecasts?return_response";
-        String body = "{\"entity_id\":\"" + String(HA_ENTITY_WEATHER) + "\",\"type\":\"daily\"}";
+        String body = "{\"entity_id\":\"" + String(HA_ENTITY_WEATHER) + "\",\"type\":\"" HA_FORECAST_TYPE "\"}";
         JsonDocument doc;
 
         if (!ha_post(url, body, doc)) {
@@ -201,16 +213,30 @@ static void fetch_forecast(HAForecastDay forecast[3]) {
         }
 
         Serial.printf("[%s] Forecast from service call\n", TAG);
-        parse_forecast_array(fc, forecast);
+        parse_forecast_array(fc, forecast, count);
     }
 }
 
 void ha_fetch_all(HAWeatherData& data) {
+    uint32_t t0 = millis();
+    uint32_t t = t0;
+    auto step_done = [&](HAFetchStep step) {
+        uint32_t now = millis();
+        fetch_timings.step_ms[step] = now - t;
+        t = now;
+    };
+
     fetch_temperature(HA_ENTITY_INDOOR_TEMP, data.indoor_temp);
+    step_done(HA_FETCH_INDOOR);
     fetch_temperature(HA_ENTITY_OUTDOOR_TEMP, data.outdoor_temp);
+    step_done(HA_FETCH_OUTDOOR);
     fetch_climate_temperature(HA_ENTITY_SAUNA_TEMP, data.sauna_temp);
+    step_done(HA_FETCH_SAUNA);
     fetch_current_weather(data.current);
-    fetch_forecast(data.forecast);
+    step_done(HA_FETCH_WEATHER);
+    fetch_forecast(data.forecast, data.forecast_count);
+    step_done(HA_FETCH_FORECAST);
+    fetch_timings.total_ms = t - t0;
 
     // Timestamp
     struct tm timeinfo;
@@ -226,3 +252,67 @@ void ha_fetch_all(HAWeatherData& data) {
     }
     data.has_data = true;
 }
+
+void ha_get_fetch_timings(HAFetchTimings& out) {
+    out = fetch_timings;
+}
+
+// 24 h of a chatty sensor is thousands of points, so the body is pushed
+// through history_backfill as it arrives instead of into a JsonDocument.
+// The sauna is a climate entity: its temperature is an attribute, which
+// minimal_response drops after the first point. Runs on the net task, so
+// the result is staged; ui_post_history() merges it on the UI task.
+HAHistoryResult ha_fetch_history(uint32_t now_s) {
+    time_t start = now_s - (uint32_t)TEMP_HISTORY_SLOTS * TEMP_HISTORY_INTERVAL_S;
+    struct tm tm_val;
+    gmtime_r(&start, &tm_val);
+    char ts[32];
+    strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%S%%2B00:00", &tm_val);
+    String url = String(HA_BASE_URL) + "/api/history/period/" + ts +
+                 "?filter_entity_id=" HA_ENTITY_INDOOR_TEMP "," HA_ENTITY_OUTDOOR_TEMP
+                 "&minimal_response&no_attributes";
+
+    HTTPClient http;
+    http.useHTTP10(true);   // no chunked transfer encoding: the stream is the JSON
+    http.begin(url);
+    http.addHeader("Authorization", String("Bearer ") + HA_TOKEN);
+    http.setTimeout(5000);
+
+    int code = http.GET();
+    if (code != 200) {
+        Serial.printf("[%s] GET history failed: %d\n", TAG, code);
+        http.end();
+        return code >= 400 && code < 500 ? HA_HISTORY_FAILED : HA_HISTORY_RETRY;
+    }
+
+    HistoryBackfill b;
+    history_backfill_begin(b, now_s, true);
+    history_backfill_add(b, HA_ENTITY_INDOOR_TEMP, TEMP_INDOOR);
+    history_backfill_add(b, HA_ENTITY_OUTDOOR_TEMP, TEMP_OUTDOOR);
+
+    WiFiClient* stream = http.getStreamPtr();
+    int remaining = http.getSize();   // -1 without Content-Length
+    char buf[512];
+    uint32_t t0 = millis();
+    while (remaining != 0 && millis() - t0 < HA_HISTORY_TIMEOUT_MS) {
+        size_t avail = stream->available();
+        if (!avail) {
+            if (!http.connected()) break;
+            delay(1);
+            continue;
+        }
+        int n = stream->readBytes(buf, avail < sizeof(buf) ? avail : sizeof(buf));
+        if (n <= 0) break;
+        history_backfill_feed(b, buf, n);
+        if (remaining > 0) remaining -= n;
+    }
+    bool complete = remaining == 0 || (remaining < 0 && !http.connected());
+    http.end();
+    history_backfill_end(b);
+
+    Serial.printf("[%s] History: %lu bytes, %lu points (%lu skipped) -> %lu slots in %lu ms%s\n", TAG,
+                  (unsigned long)b.stats.bytes, (unsigned long)b.stats.points,
+                  (unsigned long)b.stats.skipped, (unsigned long)b.stats.slots,
+                  (unsigned long)(millis() - t0), complete ? "" : " (incomplete)");
+    return complete ? HA_HISTORY_OK : HA_HISTORY_RETRY;
+}
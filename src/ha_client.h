@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "config.h"
 
 struct HATemperature {
     float value;
@@ -15,10 +16,11 @@ struct HACurrentWeather {
 };
 
 struct HAForecastDay {
-    String day_name;    // e.g. "Wed"
+    String day_name;    // e.g. "Wed" (daily) or "14:00" (hourly)
     String condition;
     float  temp_high;
     float  temp_low;
+    bool   has_low;     // hourly forecasts carry no templow
     bool   valid;
 };
 
@@ -27,10 +29,32 @@ struct HAWeatherData {
     HATemperature    outdoor_temp;
     HATemperature    sauna_temp;
     HACurrentWeather current;
-    HAForecastDay    forecast[3];
+    HAForecastDay    forecast[HA_FORECAST_MAX];
+    uint8_t          forecast_count;  // valid entries in forecast[]
     String           last_updated;  // "HH:MM"
     bool             has_data;
 };
 
+// Duration of each request in the last ha_fetch_all() (performance HUD)
+enum HAFetchStep {
+    HA_FETCH_INDOOR, HA_FETCH_OUTDOOR, HA_FETCH_SAUNA, HA_FETCH_WEATHER, HA_FETCH_FORECAST,
+    HA_FETCH_STEPS
+};
+
+struct HAFetchTimings {
+    uint32_t step_ms[HA_FETCH_STEPS];
+    uint32_t total_ms;
+};
+
 void ha_client_init();
 void ha_fetch_all(HAWeatherData& data);
+void ha_get_fetch_timings(HAFetchTimings& out);
+enum HAHistoryResult {
+    HA_HISTORY_OK,
+    HA_HISTORY_RETRY,    // no connection, 5xx or a response cut short
+    HA_HISTORY_FAILED,   // 4xx (e.g. recorder disabled): asking again will not help
+};
+
+// Stage the temperature history of the last 24 h from HA's recorder (sensor
+// entities only) for temp_history_commit_stage() on the UI task
+HAHistoryResult ha_fetch_history(uint32_t now_s);
@@ -0,0 +1,210 @@
+#include "history_backfill.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Nesting: 1 = outer array, 2 = one entity's array, 3 = a state object
+#define DEPTH_ENTITY 2
+#define DEPTH_POINT  3
+
+// ----- Time -----
+static int digits(const char*& p, int n) {
+    int v = 0;
+    for (int i = 0; i < n; i++, p++) {
+        if (*p < '0' || *p > '9') return -1;
+        v = v * 10 + (*p - '0');
+    }
+    return v;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+static int32_t days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    int32_t era = (y >= 0 ? y : y - 399) / 400;
+    int32_t yoe = y - era * 400;
+    int32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+uint32_t history_parse_time(const char* iso) {
+    const char* p = iso;
+    int y = digits(p, 4);
+    if (y < 0 || *p++ != '-') return 0;
+    int mo = digits(p, 2);
+    if (mo < 1 || mo > 12 || *p++ != '-') return 0;
+    int d = digits(p, 2);
+    if (d < 1 || d > 31 || (*p != 'T' && *p != ' ')) return 0;
+    p++;
+    int h = digits(p, 2);
+    if (h < 0 || *p++ != ':') return 0;
+    int mi = digits(p, 2);
+    if (mi < 0 || *p++ != ':') return 0;
+    int s = digits(p, 2);
+    if (s < 0) return 0;
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+
+    int32_t offset = 0;
+    if (*p == '+' || *p == '-') {
+        int sign = *p++ == '-' ? -1 : 1;
+        int oh = digits(p, 2);
+        if (*p == ':') p++;
+        int om = digits(p, 2);
+        if (oh < 0 || om < 0) return 0;
+        offset = sign * (oh * 3600 + om * 60);
+    }
+
+    int64_t t = (int64_t)days_from_civil(y, mo, d) * 86400 + h * 3600 + mi * 60 + s - offset;
+    return t > 0 && t <= UINT32_MAX ? (uint32_t)t : 0;
+}
+
+// ----- Downsampling -----
+static void put_slot(HistoryBackfill& b, int e, uint32_t slot, float value) {
+    if (slot < b.first_slot || slot >= b.end_slot) return;
+    if (b.staged) temp_history_stage(b.sensor[e], slot * TEMP_HISTORY_INTERVAL_S, value);
+    else temp_history_put(b.sensor[e], slot * TEMP_HISTORY_INTERVAL_S, value);
+    b.stats.slots++;
+}
+
+// Close the accumulated slot and hold its last state up to (excluding) `until`
+static void flush(HistoryBackfill& b, int e, uint32_t until) {
+    auto& a = b.acc[e];
+    if (!a.n) return;
+    put_slot(b, e, a.slot, a.sum / a.n);
+    uint32_t from = a.slot + 1 > b.first_slot ? a.slot + 1 : b.first_slot;
+    if (until > b.end_slot) until = b.end_slot;
+    for (uint32_t s = from; s < until; s++) put_slot(b, e, s, a.last);
+}
+
+static void add_point(HistoryBackfill& b, int e, uint32_t t, float value) {
+    auto& a = b.acc[e];
+    uint32_t slot = t / TEMP_HISTORY_INTERVAL_S;
+    // The state at the window start may be reported with an older last_changed
+    if (slot < b.first_slot) slot = b.first_slot;
+    if (a.n && slot <= a.slot) {
+        a.sum += value;
+        a.n++;
+        a.last = value;
+        return;
+    }
+    flush(b, e, slot);
+    a.slot = slot;
+    a.sum  = value;
+    a.n    = 1;
+    a.last = value;
+}
+
+// ----- Parsing -----
+static void point_done(HistoryBackfill& b) {
+    char* end;
+    float v = strtof(b.state, &end);
+    if (b.current < 0 || !b.changed_s || end == b.state || *end) {
+        b.stats.skipped++;
+        return;
+    }
+    b.stats.points++;
+    add_point(b, b.current, b.changed_s, v);
+}
+
+// A complete string at point level: a key, or the value of the last key
+static void string_done(HistoryBackfill& b) {
+    if (b.depth != DEPTH_POINT) return;
+    const char* s = b.str_overflow ? "" : b.str;
+    if (b.expect_key) {
+        strncpy(b.key, s, sizeof(b.key) - 1);
+        b.key[sizeof(b.key) - 1] = '\0';
+        return;
+    }
+    if (strcmp(b.key, "state") == 0) {
+        strncpy(b.state, s, sizeof(b.state) - 1);
+        b.state[sizeof(b.state) - 1] = '\0';
+    } else if (strcmp(b.key, "last_changed") == 0) {
+        b.changed_s = history_parse_time(s);
+    } else if (strcmp(b.key, "entity_id") == 0) {
+        b.current = -1;
+        for (int e = 0; e < b.entities; e++) {
+            if (strcmp(b.entity_id[e], s) == 0) b.current = e;
+        }
+    }
+}
+
+void history_backfill_feed(HistoryBackfill& b, const char* data, size_t len) {
+    b.stats.bytes += len;
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        if (b.in_string) {
+            if (b.escape) {
+                b.escape = false;
+            } else if (c == '\\') {
+                b.escape = true;
+                continue;
+            } else if (c == '"') {
+                b.in_string = false;
+                b.str[b.str_len] = '\0';
+                string_done(b);
+                continue;
+            }
+            if (b.str_len < sizeof(b.str) - 1) b.str[b.str_len++] = c;
+            else b.str_overflow = true;
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            b.in_string = true;
+            b.str_len = 0;
+            b.str_overflow = false;
+            break;
+        case '[':
+        case '{':
+            b.depth++;
+            if (b.depth == DEPTH_ENTITY) b.current = -1;
+            if (b.depth == DEPTH_POINT) {
+                b.expect_key = true;
+                b.key[0] = '\0';
+                b.state[0] = '\0';
+                b.changed_s = 0;
+            }
+            break;
+        case ']':
+        case '}':
+            if (c == '}' && b.depth == DEPTH_POINT) point_done(b);
+            if (b.depth) b.depth--;
+            break;
+        case ',':
+            if (b.depth == DEPTH_POINT) b.expect_key = true;
+            break;
+        case ':':
+            if (b.depth == DEPTH_POINT) b.expect_key = false;
+            break;
+        default:
+            break;   // whitespace, numbers and literals are not used
+        }
+    }
+}
+
+// ----- Setup -----
+void history_backfill_begin(HistoryBackfill& b, uint32_t now_s, bool staged) {
+    memset(&b, 0, sizeof(b));
+    b.staged     = staged;
+    if (staged) temp_history_stage_clear();
+    b.end_slot   = now_s / TEMP_HISTORY_INTERVAL_S;
+    b.first_slot = b.end_slot - (TEMP_HISTORY_SLOTS - 1);
+    b.current    = -1;
+}
+
+void history_backfill_add(HistoryBackfill& b, const char* entity_id, TempSensor sensor) {
+    if (b.entities >= HISTORY_BACKFILL_MAX_ENTITIES) return;
+    b.entity_id[b.entities] = entity_id;
+    b.sensor[b.entities] = sensor;
+    b.entities++;
+}
+
+void history_backfill_end(HistoryBackfill& b) {
+    for (int e = 0; e < b.entities; e++) {
+        flush(b, e, b.end_slot);
+        b.acc[e].n = 0;
+    }
+}
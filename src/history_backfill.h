@@ -0,0 +1,63 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "temp_history.h"
+
+// Streaming reader for HA's /api/history/period response with
+// minimal_response: [[{"entity_id":..,"state":..,"last_changed":..}, {"state":..,
+// "last_changed":..}, ..], ..]. Bytes are pushed in chunks of any size as they
+// arrive, so the whole response (thousands of points) is never held in
+// memory. Numeric states are averaged per history slot and carried forward
+// across slots without a change, straight into the temp_history rings.
+#define HISTORY_BACKFILL_MAX_ENTITIES 4
+
+struct HistoryBackfillStats {
+    uint32_t bytes;
+    uint32_t points;    // numeric states used
+    uint32_t skipped;   // "unavailable", unknown entity, unparsable
+    uint32_t slots;     // history slots written
+};
+
+struct HistoryBackfill {
+    // Setup
+    const char* entity_id[HISTORY_BACKFILL_MAX_ENTITIES];
+    TempSensor  sensor[HISTORY_BACKFILL_MAX_ENTITIES];
+    int         entities;
+    uint32_t    first_slot;   // window, in TEMP_HISTORY_INTERVAL_S slots
+    uint32_t    end_slot;     // exclusive: the live poll owns the current slot
+    bool        staged;       // write to the temp_history staging copy
+
+    // Tokenizer
+    uint8_t depth;
+    bool    in_string;
+    bool    escape;
+    bool    expect_key;
+    char    key[16];
+    char    str[64];
+    uint8_t str_len;
+    bool    str_overflow;
+
+    // Object being read
+    int      current;        // entity of the current inner array, -1 = unknown
+    char     state[16];
+    uint32_t changed_s;
+
+    // Per-entity slot accumulator
+    struct {
+        uint32_t slot;
+        float    sum;
+        uint16_t n;
+        float    last;
+    } acc[HISTORY_BACKFILL_MAX_ENTITIES];
+
+    HistoryBackfillStats stats;
+};
+
+// staged: fill the temp_history staging copy (from a task other than the UI)
+void history_backfill_begin(HistoryBackfill& b, uint32_t now_s, bool staged = false);
+void history_backfill_add(HistoryBackfill& b, const char* entity_id, TempSensor sensor);
+void history_backfill_feed(HistoryBackfill& b, const char* data, size_t len);
+void history_backfill_end(HistoryBackfill& b);   // flush, carry forward to now
+
+// "2024-01-15T14:03:22.123456+00:00" -> epoch seconds, 0 if malformed
+uint32_t history_parse_time(const char* iso);
@@ -0,0 +1,115 @@
+#include "icon_cache.h"
+#include "config.h"
+#include "weather_icons.h"
+#include <string.h>
+
+#define ICON_CACHE_MAX 40   // 15 icons x 2 sizes with room to spare
+
+typedef struct {
+    uint32_t         letter;
+    const lv_font_t* font;
+    uint16_t         tint;       // lv_color_t.full
+    lv_img_dsc_t     img;
+} icon_entry_t;
+
+static icon_entry_t entries[ICON_CACHE_MAX];
+static uint8_t      entry_count = 0;
+static size_t       cache_bytes = 0;
+
+static const char* const ALL_ICONS[] = {
+    ICON_WEATHER_CLOUDY, ICON_WEATHER_FOG, ICON_WEATHER_HAIL, ICON_WEATHER_LIGHTNING,
+    ICON_WEATHER_NIGHT, ICON_WEATHER_PARTLY_CLOUDY, ICON_WEATHER_POURING, ICON_WEATHER_RAINY,
+    ICON_WEATHER_SNOWY, ICON_WEATHER_SUNNY, ICON_WEATHER_SUNSET_UP, ICON_WEATHER_WINDY,
+    ICON_WEATHER_WINDY_VARIANT, ICON_WEATHER_LIGHTNING_RAINY, ICON_WEATHER_SUNNY_ALERT,
+};
+
+// Rasterize one glyph the way lv_draw_label places it: x at ofs_x, y from
+// the baseline, into a tint-colored image whose alpha is the glyph coverage
+static bool render(icon_entry_t* e, lv_color_t tint) {
+    lv_font_glyph_dsc_t g;
+    if (!lv_font_get_glyph_dsc(e->font, &g, e->letter, 0)) return false;
+
+    const lv_font_t* font = g.resolved_font ? g.resolved_font : e->font;
+    const uint8_t* bmp = lv_font_get_glyph_bitmap(font, e->letter);
+    uint8_t bpp = g.bpp;
+    if (!bmp || (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)) return false;
+
+    lv_coord_t w = g.adv_w;
+    lv_coord_t h = lv_font_get_line_height(e->font);
+    size_t size = (size_t)w * h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+    uint8_t* data = (uint8_t*)lv_mem_alloc(size);
+    if (!data) return false;
+
+    for (size_t i = 0; i < size; i += LV_IMG_PX_SIZE_ALPHA_BYTE) {
+        memcpy(&data[i], &tint, sizeof(tint));
+        data[i + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = LV_OPA_TRANSP;
+    }
+
+    lv_coord_t x0 = g.ofs_x;
+    lv_coord_t y0 = (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+    uint8_t mask = (1 << bpp) - 1;
+    for (lv_coord_t gy = 0; gy < g.box_h; gy++) {
+        lv_coord_t y = y0 + gy;
+        if (y < 0 || y >= h) continue;
+        for (lv_coord_t gx = 0; gx < g.box_w; gx++) {
+            lv_coord_t x = x0 + gx;
+            if (x < 0 || x >= w) continue;
+            // Glyph bitmaps are packed MSB first without row padding
+            uint32_t bit = ((uint32_t)gy * g.box_w + gx) * bpp;
+            uint8_t v = (bmp[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+            data[((size_t)y * w + x) * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] =
+                (uint8_t)(v * 255 / mask);
+        }
+    }
+
+    e->img.header.always_zero = 0;
+    e->img.header.cf          = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    e->img.header.w           = w;
+    e->img.header.h           = h;
+    e->img.data_size          = size;
+    e->img.data               = data;
+    cache_bytes += size;
+    return true;
+}
+
+const lv_img_dsc_t* icon_cache_get(const char* icon, const lv_font_t* font, lv_color_t tint) {
+#if UI_ICON_CACHE
+    uint32_t ofs = 0;
+    uint32_t letter = _lv_txt_encoded_next(icon, &ofs);
+
+    for (uint8_t i = 0; i < entry_count; i++) {
+        icon_entry_t* e = &entries[i];
+        if (e->letter == letter && e->font == font && e->tint == tint.full) return &e->img;
+    }
+    if (entry_count >= ICON_CACHE_MAX) return nullptr;
+
+    icon_entry_t* e = &entries[entry_count];
+    e->letter = letter;
+    e->font   = font;
+    e->tint   = tint.full;
+    if (!render(e, tint)) return nullptr;
+    entry_count++;
+    return &e->img;
+#else
+    (void)icon;
+    (void)font;
+    (void)tint;
+    return nullptr;
+#endif
+}
+
+void icon_cache_prewarm(const lv_font_t* font, lv_color_t tint) {
+    for (const char* icon : ALL_ICONS) icon_cache_get(icon, font, tint);
+}
+
+size_t icon_cache_bytes() {
+    return cache_bytes;
+}
+
+void icon_cache_clear() {
+    // Images may still be referenced by widgets; only call after deleting them
+    for (uint8_t i = 0; i < entry_count; i++) lv_mem_free((void*)entries[i].img.data);
+    entry_count = 0;
+    cache_bytes = 0;
+    lv_img_cache_invalidate_src(nullptr);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <lvgl.h>
+#include <stddef.h>
+
+// Pre-rendered weather icons. Each (icon, font, tint) is rasterized once from
+// its font glyph into an LV_IMG_CF_TRUE_COLOR_ALPHA image the size of the
+// label the glyph would occupy (advance width x line height), so redraws blit
+// pixels instead of decoding and blending the 4 bpp glyph bitmap every time.
+
+// Cached image for the first glyph of `icon`, rendered on first use.
+// Returns nullptr if the cache is disabled/full or the glyph is missing;
+// callers then draw the icon as text.
+const lv_img_dsc_t* icon_cache_get(const char* icon, const lv_font_t* font, lv_color_t tint);
+
+// Render every icon in weather_icons.h for this font and tint (startup)
+void icon_cache_prewarm(const lv_font_t* font, lv_color_t tint);
+
+size_t icon_cache_bytes();   // pixel memory held by the cache
+void   icon_cache_clear();
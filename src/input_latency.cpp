@@ -0,0 +1,194 @@
+#include "input_latency.h"
+#include "serial_console.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+
+static const char* TAG = "LAT";
+
+static const char* const PHASE_NAMES[LAT_PHASES] = {
+    "edge->read", "read->click", "click->inval", "inval->render", "render->photon",
+};
+
+// Previous driver callbacks, still called
+static void (*prev_rounder)(lv_disp_drv_t*, lv_area_t*) = nullptr;
+static void (*prev_render_start)(lv_disp_drv_t*) = nullptr;
+static void (*prev_monitor)(lv_disp_drv_t*, uint32_t, uint32_t) = nullptr;
+static void (*prev_feedback)(lv_indev_drv_t*, uint8_t) = nullptr;
+
+static std::atomic<uint32_t> edge_us(0);
+static uint32_t last_edge_us = 0;
+static uint32_t last_read_us = 0;
+
+// The click being followed
+static bool     armed = false;
+static uint32_t stamp[LAT_PHASES + 1];   // edge, read, click, inval, render, photon
+static lv_timer_t* pass_check = nullptr;   // pending until the click's lv_timer_handler pass ends
+
+// Objects whose clicks redraw something (input_latency_track)
+static lv_obj_t* targets[INPUT_LATENCY_MAX_TARGETS];
+
+static InputLatencyStats stats = {};
+
+static void complete(uint32_t now) {
+    stamp[LAT_PHASES] = now;
+    uint32_t total = now - stamp[0];
+    stats.samples++;
+    stats.last_us = total;
+    if (total > stats.max_us) stats.max_us = total;
+    stats.total_us += total;
+    for (int p = 0; p < LAT_PHASES; p++) stats.phase_us[p] += stamp[p + 1] - stamp[p];
+    int b = total ? 31 - __builtin_clz(total) : 0;
+    stats.hist[b < INPUT_LATENCY_BUCKETS ? b : INPUT_LATENCY_BUCKETS - 1]++;
+    armed = false;
+}
+
+// ----- Driver hooks -----
+static void rounder_cb(lv_disp_drv_t* drv, lv_area_t* area) {
+    if (armed && !stamp[3]) stamp[3] = micros();
+    if (prev_rounder) prev_rounder(drv, area);
+}
+
+static void render_start_cb(lv_disp_drv_t* drv) {
+    if (armed && stamp[3] && !stamp[4]) stamp[4] = micros();
+    if (prev_render_start) prev_render_start(drv);
+}
+
+static void monitor_cb(lv_disp_drv_t* drv, uint32_t time, uint32_t px) {
+    if (armed && stamp[4]) complete(micros());
+    if (prev_monitor) prev_monitor(drv, time, px);
+}
+
+static bool is_target(lv_obj_t* obj) {
+    // The CLICKED event bubbles up to the handler's object
+    for (; obj; obj = lv_obj_has_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE) ? lv_obj_get_parent(obj) : nullptr) {
+        for (int i = 0; i < INPUT_LATENCY_MAX_TARGETS; i++) {
+            if (targets[i] == obj) return true;
+        }
+    }
+    return false;
+}
+
+// Created with the sample, so lv_timer_handler() restarts its timer list and
+// runs this right after the indev timer: before the refresh, the animations
+// or any other timer could invalidate on their own
+static void pass_check_cb(lv_timer_t* t) {
+    (void)t;
+    pass_check = nullptr;   // repeat count 1: LVGL deletes the timer
+    if (armed && !stamp[3]) {
+        stats.no_redraw++;
+        armed = false;
+    }
+}
+
+static void feedback_cb(lv_indev_drv_t* drv, uint8_t code) {
+    // Called for every object the event reaches; pass_check still pending
+    // means this is the same click bubbling up
+    if (code == LV_EVENT_CLICKED && !pass_check && is_target(lv_indev_get_obj_act())) {
+        if (armed) stats.no_redraw++;
+        armed = true;
+        memset(stamp, 0, sizeof(stamp));
+        stamp[0] = last_edge_us;
+        stamp[1] = last_read_us;
+        stamp[2] = micros();
+        pass_check = lv_timer_create(pass_check_cb, 0, nullptr);
+        lv_timer_set_repeat_count(pass_check, 1);
+    }
+    if (prev_feedback) prev_feedback(drv, code);
+}
+
+static void target_delete_cb(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_target(e);
+    for (int i = 0; i < INPUT_LATENCY_MAX_TARGETS; i++) {
+        if (targets[i] == obj) targets[i] = nullptr;
+    }
+}
+
+void input_latency_track(lv_obj_t* obj) {
+    int free_slot = -1;
+    for (int i = 0; i < INPUT_LATENCY_MAX_TARGETS; i++) {
+        if (targets[i] == obj) return;
+        if (!targets[i] && free_slot < 0) free_slot = i;
+    }
+    if (free_slot < 0) {
+        Serial.printf("[%s] too many click targets, not timing this one\n", TAG);
+        return;
+    }
+    targets[free_slot] = obj;
+    lv_obj_add_event_cb(obj, target_delete_cb, LV_EVENT_DELETE, nullptr);
+}
+
+void input_latency_attach_disp(lv_disp_drv_t* drv) {
+    if (drv->monitor_cb == monitor_cb) return;
+    // An identity rounder_cb is the only per-invalidation hook in LVGL 8.3
+    prev_rounder      = drv->rounder_cb;
+    prev_render_start = drv->render_start_cb;
+    prev_monitor      = drv->monitor_cb;
+    drv->rounder_cb      = rounder_cb;
+    drv->render_start_cb = render_start_cb;
+    drv->monitor_cb      = monitor_cb;
+}
+
+void input_latency_attach_indev(lv_indev_drv_t* drv) {
+    if (drv->feedback_cb == feedback_cb) return;
+    prev_feedback = drv->feedback_cb;
+    drv->feedback_cb = feedback_cb;
+}
+
+void IRAM_ATTR input_latency_edge() {
+    edge_us.store(micros() | 1);   // never 0, which means "no edge"
+}
+
+void input_latency_read(bool pressed) {
+    (void)pressed;
+    uint32_t now = micros();
+    uint32_t edge = edge_us.exchange(0);
+    // Without INT (or a stale edge) the read is the earliest timestamp we have
+    last_edge_us = edge && now - edge < 1000000 ? edge : now;
+    last_read_us = now;
+}
+
+// ----- Reporting -----
+void input_latency_get(InputLatencyStats& out) {
+    out = stats;
+}
+
+uint32_t input_latency_percentile_us(const InputLatencyStats& s, float frac) {
+    uint32_t target = (uint32_t)(s.samples * frac);
+    uint32_t n = 0;
+    for (int b = 0; b < INPUT_LATENCY_BUCKETS; b++) {
+        n += s.hist[b];
+        if (n > target) return 2u << b;
+    }
+    return 2u << (INPUT_LATENCY_BUCKETS - 1);
+}
+
+void input_latency_reset() {
+    memset(&stats, 0, sizeof(stats));
+    armed = false;
+}
+
+void input_latency_dump() {
+    uint32_t n = stats.samples ? stats.samples : 1;
+    Serial.printf("[%s] %lu clicks (%lu without redraw): avg %.1f ms, max %.1f ms, p50 <= %.1f ms, p99 <= %.1f ms\n",
+                  TAG, (unsigned long)stats.samples, (unsigned long)stats.no_redraw,
+                  stats.total_us / 1000.0 / n, stats.max_us / 1000.0,
+                  input_latency_percentile_us(stats, 0.5f) / 1000.0,
+                  input_latency_percentile_us(stats, 0.99f) / 1000.0);
+    for (int p = 0; p < LAT_PHASES; p++) {
+        Serial.printf("[%s]   %-15s avg %8.2f ms\n", TAG, PHASE_NAMES[p], stats.phase_us[p] / 1000.0 / n);
+    }
+    for (int b = 0; b < INPUT_LATENCY_BUCKETS; b++) {
+        if (!stats.hist[b]) continue;
+        Serial.printf("[%s]   < %7.1f ms %6lu\n", TAG, (2u << b) / 1000.0, (unsigned long)stats.hist[b]);
+    }
+}
+
+static void cmd_lat(const char* args) {
+    if (strcmp(args, "reset") == 0) input_latency_reset();
+    else input_latency_dump();
+}
+
+void input_latency_init() {
+    serial_console_add("lat", "touch-to-photon latency of clicks: lat [reset]", cmd_lat);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// Touch-to-photon latency of clicks. Each click is followed through:
+//   edge    touch INT edge (or scripted input in the simulator)
+//   read    controller read that saw the press/release change
+//   click   LV_EVENT_CLICKED (indev feedback_cb)
+//   inval   first invalidation after the click (disp rounder_cb)
+//   render  render start of the next refresh
+//   photon  that refresh fully flushed (monitor_cb)
+// Totals (edge -> photon; read -> photon when polling without INT) go into a
+// log2 histogram. Only clicks on tracked objects are followed; one that has
+// not invalidated anything by the end of its lv_timer_handler() pass is
+// counted but not timed, so a later unrelated redraw cannot complete it.
+
+#define INPUT_LATENCY_BUCKETS     21   // [2^i, 2^(i+1)) us, last bucket >= ~1 s
+#define INPUT_LATENCY_MAX_TARGETS 8
+
+enum InputLatencyPhase {
+    LAT_EDGE_READ, LAT_READ_CLICK, LAT_CLICK_INVAL, LAT_INVAL_RENDER, LAT_RENDER_PHOTON,
+    LAT_PHASES
+};
+
+struct InputLatencyStats {
+    uint32_t samples;
+    uint32_t no_redraw;              // tracked clicks with no invalidation in their pass
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint64_t phase_us[LAT_PHASES];   // summed per phase
+    uint32_t hist[INPUT_LATENCY_BUCKETS];
+};
+
+// Chain onto the display callbacks; call after redraw_stats_attach()
+void input_latency_attach_disp(lv_disp_drv_t* drv);
+void input_latency_attach_indev(lv_indev_drv_t* drv);
+
+// Time clicks on obj: one with a LV_EVENT_CLICKED handler that redraws.
+// Forgotten when obj is deleted.
+void input_latency_track(lv_obj_t* obj);
+
+void input_latency_edge();                // ISR-safe
+void input_latency_read(bool pressed);   // touch reader: state changed on this read
+
+void input_latency_init();   // "lat" serial command
+void input_latency_get(InputLatencyStats& out);
+uint32_t input_latency_percentile_us(const InputLatencyStats& s, float frac);   // bucket upper bound
+void input_latency_reset();
+void input_latency_dump();
@@ -7,27 +7,111 @@
 #include "wifi_manager.h"
 #include "ha_client.h"
 #include "ui.h"
+#include "event_loop.h"
+#include "serial_console.h"
+#include "mem_telemetry.h"
+#include "perf_hud.h"
+#include "profiler.h"
+#include "input_latency.h"
+#include "temp_history.h"
+#include "ts_store.h"
+#include "triple_buffer.h"
+#include "ui_queue.h"
+#include "tasks.h"
+#include "draw_parallel.h"
+
+// Each poll fills a blank snapshot, so a partly failed fetch never mixes
+// fresh fields with stale ones; the UI applies only complete snapshots
+static TripleBuffer<HAWeatherData> snapshots;
+static bool first_fetch_done = false;   // net task
+static bool history_done = false;       // net task: loaded or given up
+static int history_attempts = 0;
+static uint32_t history_retry_ms = 0;
+
+// WiFi event task: the status icon is updated on the UI task
+static void wifi_change_cb() {
+    ui_post_wifi(wifi_is_connected());
+}
 
-static HAWeatherData weather_data;
-static bool first_fetch_done = false;
+// Every reading to the flash log, in tenths of a degree; series = TempSensor
+static void log_readings(const HAWeatherData& data, uint32_t now) {
+    const HATemperature* temps[TEMP_SENSOR_COUNT] = {&data.indoor_temp, &data.outdoor_temp, &data.sauna_temp};
+    for (int s = 0; s < TEMP_SENSOR_COUNT; s++) {
+        if (temps[s]->valid) ts_store_append(s, now, lroundf(temps[s]->value * 10.0f));
+    }
+}
+
+// ----- Net task: WiFi, HA requests, flash log -----
+static void ha_poll() {
+    ts_store_poll();   // "ts" from the console, run here next to the appends
 
-static void ha_poll_cb(lv_timer_t* timer) {
     // Check WiFi and update status
     wifi_check_reconnect();
     bool connected = wifi_is_connected();
-    ui_set_wifi_status(connected);
+    ui_post_wifi(connected);
 
     if (!connected) return;
 
     Serial.println("Fetching HA data...");
-    ha_fetch_all(weather_data);
-    ui_update(weather_data);
+    HAWeatherData& next = snapshots.back();
+    next = HAWeatherData();
+    ha_fetch_all(next);
+    time_t now = time(nullptr);
+    if (now > 1600000000) log_readings(next, (uint32_t)now);
+    snapshots.publish();
+    ui_post_snapshot();
+
+    HAFetchTimings timings;
+    ha_get_fetch_timings(timings);
+    perf_hud_set_network(wifi_rssi(), timings);
 
     if (!first_fetch_done) {
         first_fetch_done = true;
-        ui_show_loading(false);
+        ui_post_loading(false);
         Serial.println("First data loaded - hiding loading screen");
     }
+
+    // Trend history from before this boot, once SNTP has set the clock. An
+    // attempt can block the net task for HA_HISTORY_TIMEOUT_MS: back off.
+    if (!history_done && now > 1600000000 && (int32_t)(millis() - history_retry_ms) >= 0) {
+        HAHistoryResult r = ha_fetch_history((uint32_t)now);
+        history_attempts++;
+        if (r == HA_HISTORY_OK) {
+            history_done = true;
+            ui_post_history();
+        } else if (r == HA_HISTORY_FAILED || history_attempts >= HA_HISTORY_ATTEMPTS) {
+            history_done = true;
+            Serial.println("History backfill given up - sparklines fill from live readings");
+        } else {
+            history_retry_ms = millis() + ((uint32_t)HA_POLL_INTERVAL_MS << (history_attempts - 1));
+        }
+    }
+}
+
+static void net_task(void* arg) {
+    (void)arg;
+    // Connecting blocks for up to WIFI_TIMEOUT_MS; the UI keeps animating meanwhile
+    wifi_init();
+    ui_post_wifi(wifi_is_connected());
+    wifi_on_change(wifi_change_cb);
+    ha_client_init();
+    configTime(0, 0, "pool.ntp.org");   // NTP for timestamps
+
+    for (;;) {
+        uint32_t t0 = micros();
+        ha_poll();
+        uint32_t busy_us = micros() - t0;
+        cpu_stats_add_busy(NET_TASK_CORE, busy_us);
+        uint32_t busy_ms = busy_us / 1000;
+        delay(busy_ms < HA_POLL_INTERVAL_MS ? HA_POLL_INTERVAL_MS - busy_ms : 0);
+    }
+}
+
+// ----- UI task: LVGL timers, touch, display flush -----
+static void ui_task(void* arg) {
+    (void)arg;
+    event_loop_init();
+    for (;;) event_loop_run_once();
 }
 
 void setup() {
@@ -44,27 +128,29 @@ void setup() {
 
     // Build UI (shows loading overlay initially)
     ui_create();
+    ui_set_wifi_status(false);
+    ui_queue_init(&snapshots);   // other tasks post UI changes from here on
     Serial.println("UI created");
 
-    // Initialize WiFi
-    wifi_init();
-    ui_set_wifi_status(wifi_is_connected());
-
-    // Initialize HA client
-    ha_client_init();
-
-    // Configure NTP for timestamps
-    configTime(0, 0, "pool.ntp.org");
-
-    // Create LVGL timer for HA polling every 30 seconds
-    // First poll happens immediately (delay=0 triggers on first tick)
-    lv_timer_t* poll_timer = lv_timer_create(ha_poll_cb, HA_POLL_INTERVAL_MS, nullptr);
-    lv_timer_ready(poll_timer); // trigger immediately on first loop iteration
-
+    // Diagnostics: "help" over serial
+    serial_console_init();
+    display_bench_init();
+    mem_telemetry_init();
+    perf_hud_init();
+    profiler_init();
+    input_latency_init();
+    cpu_stats_init();
+    draw_parallel_init();
+    ts_store_init();
+
+    // Everything above ran on the Arduino loop task, which ends here
+    void* ui = task_spawn("ui", ui_task, nullptr, UI_TASK_CORE, UI_TASK_PRIORITY, UI_TASK_STACK);
+    void* net = task_spawn("net", net_task, nullptr, NET_TASK_CORE, NET_TASK_PRIORITY, NET_TASK_STACK);
+    mem_telemetry_watch_task("ui", ui);
+    mem_telemetry_watch_task("net", net);
     Serial.println("Setup complete");
 }
 
 void loop() {
-    lv_timer_handler();
-    delay(5);
+    vTaskDelete(nullptr);   // the work runs in ui_task and net_task
 }
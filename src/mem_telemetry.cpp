@@ -0,0 +1,184 @@
+#include "mem_telemetry.h"
+#include "config.h"
+#include "serial_console.h"
+#include "tiered_alloc.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <string.h>
+
+#ifdef SIMULATOR
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+#else
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+static const char* TAG = "MEM";
+
+static MemSample ring[MEM_TELEMETRY_SAMPLES];
+static int ring_head = 0;    // next write
+static int ring_count = 0;
+
+static const char* task_names[MEM_TELEMETRY_MAX_TASKS];
+static void*       task_handles[MEM_TELEMETRY_MAX_TASKS];
+static int         task_count = 0;
+
+#ifdef SIMULATOR
+static uint32_t sim_min_free = UINT32_MAX;
+#endif
+
+static void read_heap(MemSample& s) {
+#ifdef SIMULATOR
+#if defined(__APPLE__)
+    malloc_statistics_t st;
+    malloc_zone_statistics(nullptr, &st);
+    s.heap_used = st.size_in_use;
+    s.heap_free = st.size_allocated - st.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi = mallinfo2();
+    s.heap_used = mi.uordblks;
+    s.heap_free = mi.fordblks;
+#else
+    struct mallinfo mi = mallinfo();
+    s.heap_used = mi.uordblks;
+    s.heap_free = mi.fordblks;
+#endif
+    if (s.heap_free < sim_min_free) sim_min_free = s.heap_free;
+    s.heap_min_free = sim_min_free;
+#else
+    const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    s.heap_free     = heap_caps_get_free_size(caps);
+    s.heap_used     = heap_caps_get_total_size(caps) - s.heap_free;
+    s.heap_min_free = heap_caps_get_minimum_free_size(caps);
+    s.heap_largest  = heap_caps_get_largest_free_block(caps);
+    s.psram_free    = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    s.psram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+#endif
+}
+
+static void read_lvgl(MemSample& s) {
+#if LV_TIERED_ALLOC
+    tiered_stats_t st;
+    tiered_alloc_get_stats(&st);
+    s.lv_used      = st.pool_used + st.bulk_used;
+    s.lv_pool_used = st.pool_used;
+    s.lv_pool_pct  = st.pool_bytes ? (uint8_t)(st.pool_used * 100 / st.pool_bytes) : 0;
+    s.lv_frag_pct  = st.heap_frag_pct;
+#else
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    s.lv_used     = mon.total_size - mon.free_size;
+    s.lv_frag_pct = mon.frag_pct;
+#endif
+}
+
+void mem_telemetry_read(MemSample& out) {
+    memset(&out, 0, sizeof(out));
+    out.uptime_s = millis() / 1000;
+    read_heap(out);
+    read_lvgl(out);
+#ifndef SIMULATOR
+    for (int i = 0; i < task_count; i++) {
+        out.stack_free[i] = uxTaskGetStackHighWaterMark((TaskHandle_t)task_handles[i]);  // bytes on ESP-IDF
+    }
+#endif
+}
+
+static void sample_timer_cb(lv_timer_t* timer) {
+    (void)timer;
+    mem_telemetry_read(ring[ring_head]);
+    ring_head = (ring_head + 1) % MEM_TELEMETRY_SAMPLES;
+    if (ring_count < MEM_TELEMETRY_SAMPLES) ring_count++;
+}
+
+int mem_telemetry_count() {
+    return ring_count;
+}
+
+bool mem_telemetry_get(int i, MemSample& out) {
+    if (i < 0 || i >= ring_count) return false;
+    int oldest = (ring_head - ring_count + MEM_TELEMETRY_SAMPLES) % MEM_TELEMETRY_SAMPLES;
+    out = ring[(oldest + i) % MEM_TELEMETRY_SAMPLES];
+    return true;
+}
+
+// One summary row: current value, min/max over the ring, change since the oldest sample
+static void print_row(const char* name, const MemSample& now, size_t offset, size_t size) {
+    auto field = [&](const MemSample& s) -> int64_t {
+        const uint8_t* p = (const uint8_t*)&s + offset;
+        if (size == 1) return *p;
+        if (size == 2) return *(const uint16_t*)p;
+        return *(const uint32_t*)p;
+    };
+    int64_t cur = field(now), lo = cur, hi = cur, first = cur;
+    MemSample s;
+    for (int i = 0; i < ring_count; i++) {
+        mem_telemetry_get(i, s);
+        int64_t v = field(s);
+        if (i == 0) first = v;
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    Serial.printf("[%s]   %-16s %10lld %10lld %10lld %+11lld\n", TAG, name,
+                  (long long)cur, (long long)lo, (long long)hi, (long long)(cur - first));
+}
+
+#define ROW(label, member) print_row(label, now, offsetof(MemSample, member), sizeof(now.member))
+
+void mem_telemetry_print(bool all) {
+    MemSample now;
+    mem_telemetry_read(now);
+    Serial.printf("[%s] uptime %lus, %d samples every %lus\n", TAG, (unsigned long)now.uptime_s,
+                  ring_count, (unsigned long)(MEM_TELEMETRY_INTERVAL_MS / 1000));
+    Serial.printf("[%s]   %-16s %10s %10s %10s %11s\n", TAG, "", "now", "min", "max", "since first");
+    ROW("heap used", heap_used);
+    ROW("heap free", heap_free);
+    ROW("heap min free", heap_min_free);
+    ROW("heap largest", heap_largest);
+    ROW("psram free", psram_free);
+    ROW("psram largest", psram_largest);
+    ROW("lvgl used", lv_used);
+    ROW("lvgl pool used", lv_pool_used);
+    ROW("lvgl pool %", lv_pool_pct);
+    ROW("lvgl frag %", lv_frag_pct);
+    for (int t = 0; t < task_count; t++) {
+        char label[24];
+        snprintf(label, sizeof(label), "stack %s", task_names[t]);
+        print_row(label, now, offsetof(MemSample, stack_free) + t * sizeof(uint16_t), sizeof(uint16_t));
+    }
+
+    if (!all) return;
+    MemSample s;
+    for (int i = 0; i < ring_count; i++) {
+        mem_telemetry_get(i, s);
+        Serial.printf("[%s] %8lus heap %lu/%lu (min %lu, blk %lu) psram %lu (blk %lu) lvgl %lu (pool %u%%, frag %u%%)",
+                      TAG, (unsigned long)s.uptime_s, (unsigned long)s.heap_used, (unsigned long)s.heap_free,
+                      (unsigned long)s.heap_min_free, (unsigned long)s.heap_largest,
+                      (unsigned long)s.psram_free, (unsigned long)s.psram_largest,
+                      (unsigned long)s.lv_used, s.lv_pool_pct, s.lv_frag_pct);
+        for (int t = 0; t < task_count; t++) Serial.printf(" %s %u", task_names[t], s.stack_free[t]);
+        Serial.printf("\n");
+    }
+}
+
+static void cmd_mem(const char* args) {
+    mem_telemetry_print(strcmp(args, "all") == 0);
+}
+
+void mem_telemetry_init() {
+    sample_timer_cb(nullptr);
+    lv_timer_create(sample_timer_cb, MEM_TELEMETRY_INTERVAL_MS, nullptr);
+    serial_console_add("mem", "memory summary ('mem all' adds every sample)", cmd_mem);
+}
+
+void mem_telemetry_watch_task(const char* name, void* task) {
+    if (task_count >= MEM_TELEMETRY_MAX_TASKS) return;
+    task_names[task_count] = name;
+    task_handles[task_count] = task;
+    task_count++;
+}
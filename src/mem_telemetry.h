@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+// Periodic memory samples kept in a ring buffer (MEM_TELEMETRY_SAMPLES every
+// MEM_TELEMETRY_INTERVAL_MS) to spot slow leaks and fragmentation on panels
+// that run for weeks. Summary on demand with the "mem" serial command.
+//
+// LVGL numbers come from tiered_alloc: with LV_MEM_CUSTOM, lv_mem_monitor()
+// only returns zeros. The simulator reads the heap from mallinfo2() /
+// malloc_zone_statistics(); PSRAM, largest block and stacks read 0 there.
+
+#define MEM_TELEMETRY_MAX_TASKS 4
+
+struct MemSample {
+    uint32_t uptime_s;
+    uint32_t heap_used;        // internal heap (simulator: process heap)
+    uint32_t heap_free;
+    uint32_t heap_min_free;    // low-water mark since boot
+    uint32_t heap_largest;     // largest free internal block
+    uint32_t psram_free;
+    uint32_t psram_largest;
+    uint32_t lv_used;          // LVGL heap in use (SRAM pools + bulk)
+    uint32_t lv_pool_used;
+    uint8_t  lv_pool_pct;      // SRAM pool blocks in use
+    uint8_t  lv_frag_pct;      // bulk heap fragmentation
+    uint16_t stack_free[MEM_TELEMETRY_MAX_TASKS];   // min free stack bytes per watched task
+};
+
+void mem_telemetry_init();   // first sample, sampling timer, "mem" command
+
+// Track a task's stack high-water mark (FreeRTOS TaskHandle_t; ignored in the simulator)
+void mem_telemetry_watch_task(const char* name, void* task);
+
+void mem_telemetry_read(MemSample& out);   // current values, not stored
+int  mem_telemetry_count();                // samples in the ring
+bool mem_telemetry_get(int i, MemSample& out);   // 0 = oldest
+void mem_telemetry_print(bool all);        // summary (+ every sample) to Serial
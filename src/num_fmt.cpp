@@ -0,0 +1,130 @@
+#include "num_fmt.h"
+#include <string.h>
+
+static const uint32_t POW10[NUM_FMT_MAX_DECIMALS + 1] = {1, 10, 100, 1000};
+
+// Digits are written backwards, ending at `end`; each helper returns the new start
+static char* put_uint(char* end, uint64_t v) {
+    if (v <= UINT32_MAX) {
+        // 32-bit division is much cheaper on the ESP32
+        uint32_t v32 = (uint32_t)v;
+        do {
+            *--end = '0' + v32 % 10;
+            v32 /= 10;
+        } while (v32);
+        return end;
+    }
+    do {
+        *--end = '0' + v % 10;
+        v /= 10;
+    } while (v);
+    return end;
+}
+
+// m * 2^e for e > 40 (up to FLT_MAX, 39 digits): 160-bit integer, 9 digits per division
+static char* put_big(char* end, uint32_t m, int e) {
+    uint32_t limb[5] = {0, 0, 0, 0, 0};   // little endian
+    uint64_t w = (uint64_t)m << (e % 32);
+    limb[e / 32]     = (uint32_t)w;
+    limb[e / 32 + 1] = (uint32_t)(w >> 32);
+
+    int top = 4;
+    for (;;) {
+        while (top >= 0 && !limb[top]) top--;
+        if (top < 0) return end;
+        uint64_t rem = 0;
+        bool more = false;
+        for (int j = top; j >= 0; j--) {
+            uint64_t cur = (rem << 32) | limb[j];
+            limb[j] = (uint32_t)(cur / 1000000000u);
+            rem = cur % 1000000000u;
+            more |= limb[j] != 0;
+        }
+        // Inner chunks are zero padded, the leading one is not
+        uint32_t r = (uint32_t)rem;
+        for (int d = 0; d < 9 && (more || r); d++) {
+            *--end = '0' + r % 10;
+            r /= 10;
+        }
+    }
+}
+
+// Same text as "%.*f", from the exact binary value of the float
+static char* format(char* end, float value, int decimals) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int      exp  = (bits >> 23) & 0xFF;
+    uint32_t mant = bits & 0x7FFFFF;
+    char* p = end;
+
+    if (exp == 0xFF) {
+        p -= 3;
+        memcpy(p, mant ? "nan" : "inf", 3);
+    } else {
+        // value = m * 2^e exactly
+        uint32_t m = exp ? mant | 0x800000 : mant;
+        int      e = exp ? exp - 150 : -149;
+
+        if (e >= 0) {
+            // Integer: fraction is all zeros
+            for (int i = 0; i < decimals; i++) *--p = '0';
+            if (decimals) *--p = '.';
+            p = e <= 40 ? put_uint(p, (uint64_t)m << e) : put_big(p, m, e);
+        } else {
+            // Round m * 10^d / 2^k to an integer, ties to even (n < 2^34)
+            uint64_t n = (uint64_t)m * POW10[decimals];
+            int k = -e;
+            uint64_t q = 0;
+            if (k < 40) {
+                q = n >> k;
+                uint64_t rem  = n & ((1ull << k) - 1);
+                uint64_t half = 1ull << (k - 1);
+                if (rem > half || (rem == half && (q & 1))) q++;
+            }   // else below half a unit of the last decimal: 0
+            uint64_t ip = q / POW10[decimals];
+            uint32_t fp = (uint32_t)(q - ip * POW10[decimals]);
+            for (int i = 0; i < decimals; i++) {
+                *--p = '0' + fp % 10;
+                fp /= 10;
+            }
+            if (decimals) *--p = '.';
+            p = put_uint(p, ip);
+        }
+    }
+    if (bits >> 31) *--p = '-';
+    return p;
+}
+
+// Append n bytes at pos, keeping room for the terminator; returns the untruncated position
+static size_t append(char* buf, size_t len, size_t pos, const char* s, size_t n) {
+    if (pos + 1 < len) {
+        size_t room = len - 1 - pos;
+        memcpy(buf + pos, s, n < room ? n : room);
+    }
+    return pos + n;
+}
+
+static size_t terminate(char* buf, size_t len, size_t pos) {
+    if (len) buf[pos < len ? pos : len - 1] = '\0';
+    return pos;
+}
+
+size_t num_fmt_fixed(char* buf, size_t len, float value, int decimals) {
+    return num_fmt_value(buf, len, nullptr, value, decimals, nullptr);
+}
+
+size_t num_fmt_value(char* buf, size_t len, const char* prefix, float value, int decimals,
+                     const char* suffix) {
+    if (decimals < 0) decimals = 0;
+    if (decimals > NUM_FMT_MAX_DECIMALS) decimals = NUM_FMT_MAX_DECIMALS;
+
+    char tmp[48];   // sign + 39 digits + point + decimals
+    char* end = tmp + sizeof(tmp);
+    char* num = format(end, value, decimals);
+
+    size_t pos = 0;
+    if (prefix) pos = append(buf, len, pos, prefix, strlen(prefix));
+    pos = append(buf, len, pos, num, end - num);
+    if (suffix) pos = append(buf, len, pos, suffix, strlen(suffix));
+    return terminate(buf, len, pos);
+}
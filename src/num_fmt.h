@@ -0,0 +1,16 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Float to text without printf: no allocation, no locale, no newlib float
+// printing. Output is identical to snprintf("%.*f") of the same value
+// (exact binary value, ties to even, "-0.0", "inf", "nan"), except that a
+// negative NaN prints "-nan" as glibc does where newlib prints "nan".
+#define NUM_FMT_MAX_DECIMALS 3
+#define NUM_FMT_DEG "\xC2\xB0"
+
+// Both return the full length like snprintf; the output is truncated to len - 1
+size_t num_fmt_fixed(char* buf, size_t len, float value, int decimals);
+// prefix + value + suffix, e.g. ("Wind: ", 12.4f, 0, " km/h") -> "Wind: 12 km/h"
+size_t num_fmt_value(char* buf, size_t len, const char* prefix, float value, int decimals,
+                     const char* suffix);
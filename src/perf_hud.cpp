@@ -0,0 +1,163 @@
+#include "perf_hud.h"
+#include "config.h"
+#include "ui_fonts.h"
+#include "redraw_stats.h"
+#include "event_loop.h"
+#include "mem_telemetry.h"
+#include "serial_console.h"
+#include "tasks.h"
+#include "triple_buffer.h"
+#include <Arduino.h>
+
+#define PERF_HUD_W 330
+#define PERF_HUD_H 104
+#define PERF_HUD_X (SCREEN_WIDTH - PERF_HUD_W - 8)
+#define PERF_HUD_Y (SCREEN_HEIGHT - PERF_HUD_H - 8)
+
+static const char* const FETCH_NAMES[HA_FETCH_STEPS] = {"in", "out", "sauna", "wx", "fc"};
+
+static lv_obj_t*   hud = nullptr;
+static lv_obj_t*   hud_label = nullptr;
+static lv_timer_t* hud_timer = nullptr;
+
+// Written by the net task, read by the HUD timer on the UI task
+struct NetStats {
+    int            rssi;
+    HAFetchTimings fetch;
+};
+static TripleBuffer<NetStats> net_stats;
+
+static uint32_t last_frames = 0;
+static uint32_t last_update_ms = 0;
+
+static void hud_timer_cb(lv_timer_t* timer) {
+    (void)timer;
+    perf_hud_update();
+}
+
+// Also runs when lv_layer_top() is cleaned under us
+static void hud_delete_cb(lv_event_t* e) {
+    (void)e;
+    if (hud_timer) lv_timer_del(hud_timer);
+    hud = nullptr;
+    hud_label = nullptr;
+    hud_timer = nullptr;
+}
+
+static void show() {
+    // Radius 0 and full opacity: LVGL starts redraws of this area at the HUD
+    // instead of repainting the widgets below it
+    hud = lv_obj_create(lv_layer_top());
+    lv_obj_set_pos(hud, PERF_HUD_X, PERF_HUD_Y);
+    lv_obj_set_size(hud, PERF_HUD_W, PERF_HUD_H);
+    lv_obj_set_style_bg_color(hud, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(hud, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(hud, 0, 0);
+    lv_obj_set_style_border_width(hud, 1, 0);
+    lv_obj_set_style_border_color(hud, lv_color_hex(0x22C55E), 0);
+    lv_obj_set_style_pad_all(hud, 6, 0);
+    lv_obj_clear_flag(hud, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_clear_flag(hud, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(hud, hud_delete_cb, LV_EVENT_DELETE, nullptr);
+
+    // Fixed size and clipped, so new text never changes the layout
+    hud_label = lv_label_create(hud);
+    lv_obj_set_size(hud_label, PERF_HUD_W - 14, PERF_HUD_H - 14);
+    lv_label_set_long_mode(hud_label, LV_LABEL_LONG_CLIP);
+    lv_obj_set_style_text_color(hud_label, lv_color_hex(0x22C55E), 0);
+    lv_obj_set_style_text_font(hud_label, UI_FONT_12, 0);
+
+    RedrawFrameStats fs;
+    redraw_stats_get_frame(fs);
+    last_frames = fs.frames;
+    last_update_ms = millis();
+    hud_timer = lv_timer_create(hud_timer_cb, PERF_HUD_UPDATE_MS, nullptr);
+    perf_hud_update();
+}
+
+void perf_hud_update() {
+    if (!hud_label) return;
+
+    RedrawFrameStats fs;
+    redraw_stats_get_frame(fs);
+    uint32_t now = millis();
+    uint32_t elapsed = now - last_update_ms;
+    float fps = elapsed ? (fs.frames - last_frames) * 1000.0f / elapsed : 0.0f;
+    last_frames = fs.frames;
+    last_update_ms = now;
+
+    EventLoopStats ls;
+    event_loop_get_stats(ls);
+    MemSample mem;
+    mem_telemetry_read(mem);
+
+    net_stats.fetch();
+    const NetStats& net = net_stats.front();
+    bool net_valid = net_stats.generation() != 0;
+    const HAFetchTimings& net_fetch = net.fetch;
+    CpuStats cpu;
+    cpu_stats_get(cpu);
+
+    char fetch[96] = "fetch -";
+    if (net_valid) {
+        int n = snprintf(fetch, sizeof(fetch), "fetch %lu ms:", (unsigned long)net_fetch.total_ms);
+        for (int i = 0; i < HA_FETCH_STEPS && n < (int)sizeof(fetch); i++) {
+            n += snprintf(fetch + n, sizeof(fetch) - n, " %s %lu", FETCH_NAMES[i],
+                          (unsigned long)net_fetch.step_ms[i]);
+        }
+    }
+    char wifi[24] = "wifi -";
+    if (net_valid && net.rssi != 0) snprintf(wifi, sizeof(wifi), "wifi %d dBm", net.rssi);
+
+    // LVGL's own printf has no %f (LV_SPRINTF_USE_FLOAT 0)
+    char text[320];
+    snprintf(text, sizeof(text),
+             "FPS %.1f  frame %.1f ms (max %.1f)\n"
+             "loop %.1f/s  idle %.0f%%  %s core0 %.0f%% core1 %.0f%%\n"
+             "heap %luk free (blk %luk)  psram %luk\n"
+             "lvgl %luk  pool %u%%  frag %u%%\n"
+             "%s\n"
+             "%s",
+             fps, fs.last_us / 1000.0f, fs.max_us / 1000.0f,
+             ls.wakeups_per_s, ls.idle_pct, cpu.from_idle_tasks ? "load" : "active", cpu.load_pct[0], cpu.load_pct[1],
+             (unsigned long)(mem.heap_free / 1024), (unsigned long)(mem.heap_largest / 1024),
+             (unsigned long)(mem.psram_free / 1024),
+             (unsigned long)(mem.lv_used / 1024), mem.lv_pool_pct, mem.lv_frag_pct,
+             wifi, fetch);
+    lv_label_set_text(hud_label, text);
+}
+
+void perf_hud_toggle() {
+    if (hud) lv_obj_del(hud);   // hud_delete_cb drops the timer
+    else show();
+}
+
+bool perf_hud_visible() {
+    return hud != nullptr;
+}
+
+static void long_press_cb(lv_event_t* e) {
+    (void)e;
+    perf_hud_toggle();
+}
+
+void perf_hud_attach_toggle(lv_obj_t* obj) {
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(obj, long_press_cb, LV_EVENT_LONG_PRESSED, nullptr);
+}
+
+void perf_hud_set_network(int rssi_dbm, const HAFetchTimings& fetch) {
+    NetStats& next = net_stats.back();
+    next.rssi  = rssi_dbm;
+    next.fetch = fetch;
+    net_stats.publish();
+}
+
+static void cmd_hud(const char* args) {
+    (void)args;
+    perf_hud_toggle();
+}
+
+void perf_hud_init() {
+    serial_console_add("hud", "toggle the on-screen performance HUD", cmd_hud);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <lvgl.h>
+#include "ha_client.h"
+
+// Field diagnostics overlay: render FPS and frame time, loop wakeups, per-core
+// load, heap and PSRAM, LVGL heap, WiFi RSSI and the last HA fetch per
+// entity. A fixed, opaque box on lv_layer_top updated every
+// PERF_HUD_UPDATE_MS, so refreshes never reach the dashboard underneath.
+// Its own 1 Hz redraw is in the FPS.
+// Nothing (no object, no timer) exists while it is hidden.
+
+void perf_hud_init();                    // "hud" serial command
+void perf_hud_attach_toggle(lv_obj_t* obj);   // long-press on obj toggles the HUD
+void perf_hud_toggle();
+bool perf_hud_visible();
+void perf_hud_update();                  // refresh the text now (timer does this)
+
+// Pushed by the net task (one producer); the HUD shows the latest values
+void perf_hud_set_network(int rssi_dbm, const HAFetchTimings& fetch);
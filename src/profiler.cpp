@@ -0,0 +1,319 @@
+#include "profiler.h"
+#include "config.h"
+#include "event_loop.h"
+#include "serial_console.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <string.h>
+
+static const char* TAG = "PROF";
+
+#define PROFILER_MAX_ENTRIES 24
+#define PROFILER_MAX_TIMERS  32
+#define PROFILER_MAX_DRIVERS 4
+
+struct Entry {
+    const void*   key;       // original callback
+    ProfilerEntry stats;
+    char          name_buf[20];
+};
+
+struct TimerSlot {
+    lv_timer_t*   timer;
+    lv_timer_cb_t orig;
+    int8_t        entry;
+    bool          seen;      // found by the current scan
+};
+
+struct DispSlot {
+    lv_disp_drv_t* drv;
+    void (*orig)(lv_disp_drv_t*, const lv_area_t*, lv_color_t*);
+    int8_t entry;
+};
+
+struct IndevSlot {
+    lv_indev_drv_t* drv;
+    void (*orig)(lv_indev_drv_t*, lv_indev_data_t*);
+    int8_t entry;
+};
+
+static bool      enabled = false;
+static Entry     entries[PROFILER_MAX_ENTRIES];
+static int       entry_count = 0;
+static TimerSlot timers[PROFILER_MAX_TIMERS];
+static DispSlot  disps[PROFILER_MAX_DRIVERS];
+static IndevSlot indevs[PROFILER_MAX_DRIVERS];
+static int       disp_count = 0;
+static int       indev_count = 0;
+static uint32_t  reset_us = 0;
+static lv_timer_t* dump_timer = nullptr;
+
+static const void* names_key[PROFILER_MAX_ENTRIES];
+static const char* names_val[PROFILER_MAX_ENTRIES];
+static int         names_count = 0;
+
+static int entry_for(const void* key, const char* name) {
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].key == key) return i;
+    }
+    if (entry_count >= PROFILER_MAX_ENTRIES) return -1;
+
+    Entry* e = &entries[entry_count];
+    memset(e, 0, sizeof(*e));
+    e->key = key;
+    for (int i = 0; i < names_count && !name; i++) {
+        if (names_key[i] == key) name = names_val[i];
+    }
+    if (!name) {
+        snprintf(e->name_buf, sizeof(e->name_buf), "cb@%p", key);
+        name = e->name_buf;
+    }
+    e->stats.name = name;
+    return entry_count++;
+}
+
+static void record(int entry, uint32_t us) {
+    if (entry < 0) return;
+    ProfilerEntry* s = &entries[entry].stats;
+    s->calls++;
+    s->total_us += us;
+    if (us > s->max_us) s->max_us = us;
+    int b = us ? 31 - __builtin_clz(us) : 0;
+    s->hist[b < PROFILER_HIST_BUCKETS ? b : PROFILER_HIST_BUCKETS - 1]++;
+}
+
+// ----- Trampolines -----
+static void timer_tramp(lv_timer_t* t) {
+    for (int i = 0; i < PROFILER_MAX_TIMERS; i++) {
+        if (timers[i].timer != t) continue;
+        // Copy first: the callback may delete its own timer
+        lv_timer_cb_t cb = timers[i].orig;
+        int entry = timers[i].entry;
+        uint32_t t0 = micros();
+        cb(t);
+        record(entry, micros() - t0);
+        return;
+    }
+}
+
+static void flush_tramp(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    for (int i = 0; i < disp_count; i++) {
+        if (disps[i].drv != drv) continue;
+        uint32_t t0 = micros();
+        disps[i].orig(drv, area, color_p);
+        record(disps[i].entry, micros() - t0);
+        return;
+    }
+}
+
+static void read_tramp(lv_indev_drv_t* drv, lv_indev_data_t* data) {
+    for (int i = 0; i < indev_count; i++) {
+        if (indevs[i].drv != drv) continue;
+        uint32_t t0 = micros();
+        indevs[i].orig(drv, data);
+        record(indevs[i].entry, micros() - t0);
+        return;
+    }
+}
+
+// LVGL's internal timers, recognized by identity
+static const char* timer_name(lv_timer_t* t) {
+    for (lv_disp_t* d = lv_disp_get_next(nullptr); d; d = lv_disp_get_next(d)) {
+        if (d->refr_timer == t) return "disp_refr";
+    }
+    for (lv_indev_t* in = lv_indev_get_next(nullptr); in; in = lv_indev_get_next(in)) {
+        if (in->driver->read_timer == t) return "indev";
+    }
+    if (lv_anim_get_timer() == t) return "anim";
+    return nullptr;
+}
+
+static void wrap_timer(lv_timer_t* t) {
+    int free_slot = -1;
+    for (int i = 0; i < PROFILER_MAX_TIMERS; i++) {
+        if (timers[i].timer == t) {
+            free_slot = i;   // address reused by a new timer, or cb replaced
+            break;
+        }
+        if (!timers[i].timer && free_slot < 0) free_slot = i;
+    }
+    if (free_slot < 0) return;
+
+    TimerSlot* s = &timers[free_slot];
+    s->timer = t;
+    s->orig  = t->timer_cb;
+    s->entry = entry_for((const void*)t->timer_cb, timer_name(t));
+    s->seen  = true;
+    t->timer_cb = timer_tramp;
+}
+
+void profiler_scan() {
+    if (!enabled) return;
+
+    for (int i = 0; i < PROFILER_MAX_TIMERS; i++) timers[i].seen = false;
+    for (lv_timer_t* t = lv_timer_get_next(nullptr); t; t = lv_timer_get_next(t)) {
+        if (t->timer_cb != timer_tramp) {
+            wrap_timer(t);
+            continue;
+        }
+        for (int i = 0; i < PROFILER_MAX_TIMERS; i++) {
+            if (timers[i].timer == t) timers[i].seen = true;
+        }
+    }
+    // Slots of deleted timers
+    for (int i = 0; i < PROFILER_MAX_TIMERS; i++) {
+        if (!timers[i].seen) timers[i].timer = nullptr;
+    }
+
+    for (lv_disp_t* d = lv_disp_get_next(nullptr); d; d = lv_disp_get_next(d)) {
+        lv_disp_drv_t* drv = d->driver;
+        if (drv->flush_cb == flush_tramp) continue;
+        int i = 0;
+        while (i < disp_count && disps[i].drv != drv) i++;
+        if (i == PROFILER_MAX_DRIVERS) continue;
+        if (i == disp_count) disp_count++;
+        disps[i] = {drv, drv->flush_cb, (int8_t)entry_for((const void*)drv->flush_cb, "flush")};
+        drv->flush_cb = flush_tramp;
+    }
+
+    for (lv_indev_t* in = lv_indev_get_next(nullptr); in; in = lv_indev_get_next(in)) {
+        lv_indev_drv_t* drv = in->driver;
+        if (drv->read_cb == read_tramp) continue;
+        int i = 0;
+        while (i < indev_count && indevs[i].drv != drv) i++;
+        if (i == PROFILER_MAX_DRIVERS) continue;
+        if (i == indev_count) indev_count++;
+        indevs[i] = {drv, drv->read_cb, (int8_t)entry_for((const void*)drv->read_cb, "indev_read")};
+        drv->read_cb = read_tramp;
+    }
+}
+
+static void unwrap_all() {
+    for (lv_timer_t* t = lv_timer_get_next(nullptr); t; t = lv_timer_get_next(t)) {
+        if (t->timer_cb != timer_tramp) continue;
+        for (int i = 0; i < PROFILER_MAX_TIMERS; i++) {
+            if (timers[i].timer == t) t->timer_cb = timers[i].orig;
+        }
+    }
+    for (int i = 0; i < PROFILER_MAX_TIMERS; i++) timers[i].timer = nullptr;
+    for (int i = 0; i < disp_count; i++) {
+        if (disps[i].drv->flush_cb == flush_tramp) disps[i].drv->flush_cb = disps[i].orig;
+    }
+    for (int i = 0; i < indev_count; i++) {
+        if (indevs[i].drv->read_cb == read_tramp) indevs[i].drv->read_cb = indevs[i].orig;
+    }
+    disp_count = 0;
+    indev_count = 0;
+}
+
+// ----- Reporting -----
+static int sorted_index(int rank) {
+    // Selection by rank, fine for a couple dozen entries
+    int order[PROFILER_MAX_ENTRIES];
+    for (int i = 0; i < entry_count; i++) {
+        int j = i;
+        while (j > 0 && entries[order[j - 1]].stats.total_us < entries[i].stats.total_us) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    return order[rank];
+}
+
+int profiler_count() {
+    return entry_count;
+}
+
+bool profiler_get(int i, ProfilerEntry& out) {
+    if (i < 0 || i >= entry_count) return false;
+    out = entries[sorted_index(i)].stats;
+    return true;
+}
+
+// Upper bound of the bucket holding the given fraction of calls
+static uint32_t percentile_us(const ProfilerEntry& e, float frac) {
+    uint32_t target = (uint32_t)(e.calls * frac);
+    uint32_t n = 0;
+    for (int b = 0; b < PROFILER_HIST_BUCKETS; b++) {
+        n += e.hist[b];
+        if (n > target) return 2u << b;
+    }
+    return 2u << (PROFILER_HIST_BUCKETS - 1);
+}
+
+void profiler_dump() {
+    double elapsed = (micros() - reset_us) / 1e6;
+    Serial.printf("[%s] %.1f s profiled (flush nests in disp_refr, indev_read in indev)\n", TAG, elapsed);
+    Serial.printf("[%s] %-20s %8s %10s %6s %8s %8s %7s %7s\n",
+                  TAG, "callback", "calls", "total ms", "wall%", "avg us", "max us", "p50<=", "p99<=");
+    ProfilerEntry e;
+    for (int i = 0; profiler_get(i, e); i++) {
+        if (!e.calls) continue;
+        Serial.printf("[%s] %-20s %8lu %10.1f %6.2f %8.1f %8lu %7lu %7lu\n",
+                      TAG, e.name, (unsigned long)e.calls, e.total_us / 1000.0,
+                      elapsed > 0 ? e.total_us / (elapsed * 1e4) : 0.0,
+                      (double)e.total_us / e.calls, (unsigned long)e.max_us,
+                      (unsigned long)percentile_us(e, 0.5f), (unsigned long)percentile_us(e, 0.99f));
+    }
+}
+
+void profiler_reset() {
+    for (int i = 0; i < entry_count; i++) {
+        const char* name = entries[i].stats.name;
+        memset(&entries[i].stats, 0, sizeof(entries[i].stats));
+        entries[i].stats.name = name;
+    }
+    reset_us = micros();
+}
+
+// ----- Control -----
+static void dump_timer_cb(lv_timer_t* timer) {
+    (void)timer;
+    profiler_dump();
+}
+
+void profiler_set_enabled(bool on) {
+    if (on == enabled) return;
+    enabled = on;
+    if (on) {
+        profiler_reset();
+        if (PROFILER_DUMP_MS > 0) dump_timer = lv_timer_create(dump_timer_cb, PROFILER_DUMP_MS, nullptr);
+        profiler_scan();
+    } else {
+        unwrap_all();
+        if (dump_timer) lv_timer_del(dump_timer);
+        dump_timer = nullptr;
+    }
+    Serial.printf("[%s] %s\n", TAG, on ? "enabled" : "disabled");
+}
+
+bool profiler_enabled() {
+    return enabled;
+}
+
+void profiler_name(const void* cb, const char* name) {
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].key == cb) entries[i].stats.name = name;
+    }
+    if (names_count < PROFILER_MAX_ENTRIES) {
+        names_key[names_count] = cb;
+        names_val[names_count] = name;
+        names_count++;
+    }
+}
+
+static void cmd_prof(const char* args) {
+    if (strcmp(args, "on") == 0) profiler_set_enabled(true);
+    else if (strcmp(args, "off") == 0) profiler_set_enabled(false);
+    else if (strcmp(args, "reset") == 0) profiler_reset();
+    else if (enabled) profiler_dump();
+    else Serial.printf("[%s] disabled, 'prof on' to start\n", TAG);
+}
+
+void profiler_init() {
+    profiler_name((const void*)dump_timer_cb, "prof_dump");
+    event_loop_on_wake(profiler_scan);
+    serial_console_add("prof", "callback profiler: prof [on|off|reset]", cmd_prof);
+    if (PROFILER) profiler_set_enabled(true);
+}
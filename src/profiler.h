@@ -0,0 +1,33 @@
+#pragma once
+#include <stdint.h>
+
+// Attributes time spent inside lv_timer_handler(). While enabled, every
+// lv_timer callback, display flush_cb and indev read_cb is swapped for a
+// timing trampoline (the original is kept in a side table and restored on
+// disable). Per callback: calls, total/max time and a log2 histogram (1 us
+// .. 32 ms+), dumped sorted by total time. Timers created later are picked
+// up by profiler_scan(), which runs on every event loop wakeup.
+//
+// LVGL's own timers are named by identity (disp_refr, indev, anim); other
+// callbacks print as their address unless named with profiler_name().
+
+#define PROFILER_HIST_BUCKETS 16
+
+struct ProfilerEntry {
+    const char* name;
+    uint32_t    calls;
+    uint64_t    total_us;
+    uint32_t    max_us;
+    uint32_t    hist[PROFILER_HIST_BUCKETS];   // bucket i: [2^i, 2^(i+1)) us, 0 also counts < 1 us
+};
+
+void profiler_init();                  // "prof" command; enables if PROFILER is set
+void profiler_set_enabled(bool on);
+bool profiler_enabled();
+void profiler_scan();                  // wrap callbacks that appeared since the last scan
+void profiler_name(const void* cb, const char* name);
+void profiler_reset();
+
+int  profiler_count();
+bool profiler_get(int i, ProfilerEntry& out);   // sorted by total time, highest first
+void profiler_dump();
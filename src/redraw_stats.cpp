@@ -0,0 +1,246 @@
+#include "redraw_stats.h"
+#include "config.h"
+#include <Arduino.h>
+
+static const char* TAG = "REDRAW";
+
+#define REDRAW_STATS_MAX_TRACKED 32
+#define REDRAW_HEAT_CELL         16     // heatmap cell size in px
+#define REDRAW_HEAT_DECAY_MS     1000   // heat halves every second
+#define REDRAW_HEAT_COLS         ((SCREEN_WIDTH + REDRAW_HEAT_CELL - 1) / REDRAW_HEAT_CELL)
+#define REDRAW_HEAT_ROWS         ((SCREEN_HEIGHT + REDRAW_HEAT_CELL - 1) / REDRAW_HEAT_CELL)
+
+// Frame timing is always collected; it is a couple of micros() calls per frame
+static RedrawFrameStats frame = {};
+static uint32_t render_start_us = 0;
+
+#if REDRAW_STATS
+struct TrackedWidget {
+    lv_obj_t*   obj;
+    const char* name;
+    uint32_t    areas;
+    uint64_t    px;
+};
+
+static TrackedWidget tracked[REDRAW_STATS_MAX_TRACKED];
+static int      tracked_count   = 0;
+static uint32_t untracked_areas = 0;
+static uint64_t untracked_px    = 0;
+
+static bool     overlay_on = REDRAW_HEATMAP;
+static uint8_t  heat[REDRAW_HEAT_ROWS][REDRAW_HEAT_COLS];
+static uint32_t last_decay_ms = 0;
+
+// ----- Attribute one invalidated area to the tracked widget it overlaps most -----
+static void attribute_area(const lv_area_t* a) {
+    int best = -1;
+    uint32_t best_ov = 0;
+    uint32_t best_size = UINT32_MAX;
+
+    for (int i = 0; i < tracked_count; i++) {
+        lv_obj_t* obj = tracked[i].obj;
+        if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) continue;
+
+        lv_area_t ov;
+        if (!_lv_area_intersect(&ov, a, &obj->coords)) continue;
+
+        // Prefer the largest overlap, then the smallest widget (spinner over overlay)
+        uint32_t ov_px = lv_area_get_size(&ov);
+        uint32_t size  = lv_area_get_size(&obj->coords);
+        if (ov_px > best_ov || (ov_px == best_ov && size < best_size)) {
+            best = i;
+            best_ov = ov_px;
+            best_size = size;
+        }
+    }
+
+    uint32_t px = lv_area_get_size(a);
+    if (best >= 0) {
+        tracked[best].areas++;
+        tracked[best].px += px;
+    } else {
+        untracked_areas++;
+        untracked_px += px;
+    }
+}
+
+static void heat_decay() {
+    uint32_t now = millis();
+    if (now - last_decay_ms < REDRAW_HEAT_DECAY_MS) return;
+    last_decay_ms = now;
+    for (int r = 0; r < REDRAW_HEAT_ROWS; r++) {
+        for (int c = 0; c < REDRAW_HEAT_COLS; c++) heat[r][c] >>= 1;
+    }
+}
+
+static lv_color_t heat_color(uint8_t h) {
+    if (h >= 16) return lv_color_hex(0xEF4444);  // red: redrawn constantly
+    if (h >= 4)  return lv_color_hex(0xF97316);  // orange
+    if (h >= 2)  return lv_color_hex(0x22C55E);  // green
+    return lv_color_hex(0x3B82F6);               // blue: redrawn once recently
+}
+
+// Bump the cells covered by a flushed area, then tint the pixels by heat
+static void heat_flush(const lv_area_t* area, lv_color_t* color_p) {
+    int c1 = area->x1 / REDRAW_HEAT_CELL, c2 = area->x2 / REDRAW_HEAT_CELL;
+    int r1 = area->y1 / REDRAW_HEAT_CELL, r2 = area->y2 / REDRAW_HEAT_CELL;
+    for (int r = r1; r <= r2 && r < REDRAW_HEAT_ROWS; r++) {
+        for (int c = c1; c <= c2 && c < REDRAW_HEAT_COLS; c++) {
+            if (heat[r][c] < 255) heat[r][c]++;
+        }
+    }
+
+    if (!overlay_on) return;
+
+    int32_t w = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        lv_color_t* px = color_p + (y - area->y1) * w;
+        const uint8_t* heat_row = heat[y / REDRAW_HEAT_CELL];
+        for (int32_t x = area->x1; x <= area->x2; x++, px++) {
+            *px = lv_color_mix(heat_color(heat_row[x / REDRAW_HEAT_CELL]), *px, LV_OPA_40);
+        }
+    }
+}
+#endif // REDRAW_STATS
+
+// ----- Display driver hooks -----
+static void render_start_cb(lv_disp_drv_t* drv) {
+    (void)drv;
+    render_start_us = micros();
+
+    // Areas merged into another one are flagged in inv_area_joined and not
+    // redrawn on their own; the merged entry already covers their pixels
+    lv_disp_t* disp = _lv_refr_get_disp_refreshing();
+    uint32_t areas = 0;
+    for (uint32_t i = 0; disp && i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i]) continue;
+        areas++;
+#if REDRAW_STATS
+        attribute_area(&disp->inv_areas[i]);
+#endif
+    }
+#if REDRAW_STATS
+    heat_decay();
+#endif
+    frame.last_areas = areas;
+    frame.total_areas += areas;
+    if (areas > frame.max_areas) frame.max_areas = areas;
+}
+
+static void monitor_cb(lv_disp_drv_t* drv, uint32_t time_ms, uint32_t px) {
+    (void)drv;
+    (void)time_ms;
+    uint32_t us = micros() - render_start_us;
+    frame.frames++;
+    frame.last_us = us;
+    frame.total_us += us;
+    if (us > frame.max_us) frame.max_us = us;
+    frame.last_px = px;
+    frame.total_px += px;
+}
+
+#if REDRAW_STATS
+static void dump_timer_cb(lv_timer_t* timer) {
+    (void)timer;
+    redraw_stats_dump();
+}
+#endif
+
+void redraw_stats_attach(lv_disp_drv_t* drv) {
+    drv->render_start_cb = render_start_cb;
+    drv->monitor_cb      = monitor_cb;
+#if REDRAW_STATS
+    if (REDRAW_STATS_DUMP_MS > 0) {
+        lv_timer_create(dump_timer_cb, REDRAW_STATS_DUMP_MS, nullptr);
+    }
+#endif
+}
+
+void redraw_stats_on_flush(const lv_area_t* area, lv_color_t* color_p) {
+#if REDRAW_STATS
+    heat_flush(area, color_p);
+#else
+    (void)area;
+    (void)color_p;
+#endif
+}
+
+void redraw_stats_track(lv_obj_t* obj, const char* name) {
+#if REDRAW_STATS
+    if (!obj || tracked_count >= REDRAW_STATS_MAX_TRACKED) return;
+    tracked[tracked_count++] = {obj, name, 0, 0};
+#else
+    (void)obj;
+    (void)name;
+#endif
+}
+
+void redraw_stats_get_frame(RedrawFrameStats& out) {
+    out = frame;
+}
+
+void redraw_stats_set_overlay(bool on) {
+#if REDRAW_STATS
+    overlay_on = on;
+    // Repaint everything so the tint appears (or disappears) at once
+    lv_obj_invalidate(lv_scr_act());
+#else
+    (void)on;
+#endif
+}
+
+bool redraw_stats_overlay_enabled() {
+#if REDRAW_STATS
+    return overlay_on;
+#else
+    return false;
+#endif
+}
+
+void redraw_stats_dump() {
+    uint32_t n = frame.frames ? frame.frames : 1;
+    Serial.printf("[%s] %lu frames, avg %.2f ms, max %.2f ms, avg %lu px, avg %.1f areas (max %lu)\n",
+                  TAG, (unsigned long)frame.frames,
+                  frame.total_us / 1000.0 / n, frame.max_us / 1000.0,
+                  (unsigned long)(frame.total_px / n),
+                  (double)frame.total_areas / n, (unsigned long)frame.max_areas);
+#if REDRAW_STATS
+    // Sort tracked widgets by invalidated pixels (insertion sort, tiny N)
+    int order[REDRAW_STATS_MAX_TRACKED];
+    for (int i = 0; i < tracked_count; i++) {
+        int j = i;
+        while (j > 0 && tracked[order[j - 1]].px < tracked[i].px) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    uint64_t all_px = untracked_px;
+    for (int i = 0; i < tracked_count; i++) all_px += tracked[i].px;
+    if (all_px == 0) all_px = 1;
+
+    Serial.printf("[%s] %-18s %8s %12s %7s\n", TAG, "source", "areas", "px", "share");
+    for (int k = 0; k < tracked_count; k++) {
+        const TrackedWidget& t = tracked[order[k]];
+        if (t.areas == 0) break;
+        Serial.printf("[%s] %-18s %8lu %12llu %6.1f%%\n", TAG, t.name,
+                      (unsigned long)t.areas, (unsigned long long)t.px, 100.0 * t.px / all_px);
+    }
+    Serial.printf("[%s] %-18s %8lu %12llu %6.1f%%\n", TAG, "(untracked)",
+                  (unsigned long)untracked_areas, (unsigned long long)untracked_px,
+                  100.0 * untracked_px / all_px);
+#endif
+}
+
+void redraw_stats_reset() {
+    frame = {};
+#if REDRAW_STATS
+    for (int i = 0; i < tracked_count; i++) {
+        tracked[i].areas = 0;
+        tracked[i].px = 0;
+    }
+    untracked_areas = 0;
+    untracked_px = 0;
+#endif
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// Frame timing collected from the display driver callbacks
+struct RedrawFrameStats {
+    uint32_t frames;         // completed refreshes
+    uint32_t last_us;        // render + flush time of the last frame
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t last_px;        // pixels rendered in the last frame
+    uint64_t total_px;
+    uint32_t last_areas;     // invalidated areas in the last frame
+    uint32_t max_areas;
+    uint64_t total_areas;
+};
+
+// Hook render_start_cb/monitor_cb of a display driver (before registering it)
+void redraw_stats_attach(lv_disp_drv_t* drv);
+
+// Call at the top of flush_cb, before the pixels leave the buffer
+void redraw_stats_on_flush(const lv_area_t* area, lv_color_t* color_p);
+
+// Name a widget so invalidated areas overlapping it are attributed to it
+void redraw_stats_track(lv_obj_t* obj, const char* name);
+
+void redraw_stats_get_frame(RedrawFrameStats& out);
+void redraw_stats_set_overlay(bool on);
+bool redraw_stats_overlay_enabled();
+void redraw_stats_dump();
+void redraw_stats_reset();
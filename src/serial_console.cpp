@@ -0,0 +1,64 @@
+#include "serial_console.h"
+#include "event_loop.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define SERIAL_CONSOLE_MAX_CMDS 12
+#define SERIAL_CONSOLE_LINE     64
+
+struct SerialCommand {
+    const char*   name;
+    const char*   help;
+    serial_cmd_fn fn;
+};
+
+static SerialCommand commands[SERIAL_CONSOLE_MAX_CMDS];
+static int  command_count = 0;
+static char line[SERIAL_CONSOLE_LINE];
+static int  line_len = 0;
+
+static void run_line() {
+    char* args = line;
+    while (*args && *args != ' ') args++;
+    size_t name_len = args - line;
+    while (*args == ' ') args++;
+    if (name_len == 0) return;
+
+    for (int i = 0; i < command_count; i++) {
+        if (strlen(commands[i].name) == name_len && strncmp(commands[i].name, line, name_len) == 0) {
+            commands[i].fn(args);
+            return;
+        }
+    }
+    Serial.printf("unknown command '%.*s' (try help)\n", (int)name_len, line);
+}
+
+static void poll_input() {
+    while (Serial.available() > 0) {
+        int c = Serial.read();
+        if (c < 0) break;
+        if (c == '\r' || c == '\n') {
+            line[line_len] = '\0';
+            run_line();
+            line_len = 0;
+        } else if (line_len < SERIAL_CONSOLE_LINE - 1) {
+            line[line_len++] = (char)c;
+        }
+    }
+}
+
+static void cmd_help(const char* args) {
+    (void)args;
+    for (int i = 0; i < command_count; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+void serial_console_init() {
+    serial_console_add("help", "list commands", cmd_help);
+    event_loop_on_wake(poll_input);
+}
+
+void serial_console_add(const char* name, const char* help, serial_cmd_fn fn) {
+    if (command_count < SERIAL_CONSOLE_MAX_CMDS) commands[command_count++] = {name, help, fn};
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+// Line-based commands over Serial (stdin in the simulator), e.g. "mem".
+// Input is polled from an event_loop_on_wake() hook, so a command runs
+// within EVENT_LOOP_MAX_SLEEP_MS of its newline without extra wakeups.
+
+typedef void (*serial_cmd_fn)(const char* args);   // text after the command name
+
+void serial_console_init();   // registers "help"
+void serial_console_add(const char* name, const char* help, serial_cmd_fn fn);
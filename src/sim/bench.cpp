@@ -0,0 +1,1740 @@
+#ifdef SIMULATOR
+
+#include "bench.h"
+#include "mock_data.h"
+#include "../config.h"
+#include "../ui.h"
+#include "../redraw_stats.h"
+#include "../forecast_strip.h"
+#include "../icon_cache.h"
+#include "../ui_fonts.h"
+#include "../event_loop.h"
+#include "../touch_reader.h"
+#include "../perf_hud.h"
+#include "../profiler.h"
+#include "../input_latency.h"
+#include "../num_fmt.h"
+#include "../temp_history.h"
+#include "../history_backfill.h"
+#include "../ts_store.h"
+#include "../triple_buffer.h"
+#include "../ui_queue.h"
+#include "../tasks.h"
+#include "../blend_kernels.h"
+#include "../draw_parallel.h"
+#include "../therm_card.h"
+#include "mock_touch.h"
+#include "tiered_alloc.h"
+
+#include <Arduino.h>
+#include <cstdio>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+struct BenchScenario {
+    const char* name;
+    const char* desc;
+    void (*run)();
+};
+
+// ----- Headless display: render into a 1/10 screen buffer, flush nowhere -----
+// FNV-1a over flushed areas and pixels while enabled, to compare renders
+static bool flush_hash_on = false;
+static uint32_t flush_hash = 2166136261u;
+
+static void hash_bytes(const void* p, size_t n) {
+    const uint8_t* b = (const uint8_t*)p;
+    for (size_t i = 0; i < n; i++) flush_hash = (flush_hash ^ b[i]) * 16777619u;
+}
+
+static void bench_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    redraw_stats_on_flush(area, color_p);
+    if (flush_hash_on) {
+        hash_bytes(area, sizeof(*area));
+        hash_bytes(color_p, lv_area_get_size(area) * sizeof(lv_color_t));
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void bench_display_init() {
+    static lv_disp_draw_buf_t draw_buf;
+    static lv_color_t buf1[SCREEN_WIDTH * (SCREEN_HEIGHT / 10)];
+    lv_disp_draw_buf_init(&draw_buf, buf1, nullptr, SCREEN_WIDTH * (SCREEN_HEIGHT / 10));
+
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res  = SCREEN_WIDTH;
+    disp_drv.ver_res  = SCREEN_HEIGHT;
+    disp_drv.flush_cb = bench_flush_cb;
+    disp_drv.draw_buf = &draw_buf;
+    redraw_stats_attach(&disp_drv);
+    input_latency_attach_disp(&disp_drv);
+    blend_kernels_attach(&disp_drv);
+    draw_parallel_attach(&disp_drv);
+    draw_parallel_set_enabled(false);   // scenarios measure the serial renderer unless they opt in
+    lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+
+    lv_theme_t* theme = lv_theme_default_init(
+        disp,
+        lv_color_hex(0x3B82F6),
+        lv_color_hex(0xEF4444),
+        true,
+        LV_FONT_DEFAULT
+    );
+    lv_disp_set_theme(disp, theme);
+}
+
+// ----- Helpers -----
+uint32_t bench_now_us() {
+    return micros();
+}
+
+uint32_t bench_refresh_us() {
+    uint32_t t0 = micros();
+    lv_refr_now(nullptr);
+    return micros() - t0;
+}
+
+void bench_settle(uint32_t ms) {
+    uint32_t start = millis();
+    while (millis() - start < ms) {
+        lv_timer_handler();
+        delay(1);
+    }
+}
+
+void bench_fresh_screen() {
+    lv_obj_t* old = lv_scr_act();
+    lv_obj_t* scr = lv_obj_create(nullptr);
+    lv_scr_load(scr);
+    lv_obj_del(old);
+    lv_obj_clean(lv_layer_top());
+    lv_refr_now(nullptr);
+    redraw_stats_reset();
+}
+
+size_t bench_heap_used() {
+#if defined(__APPLE__)
+    malloc_statistics_t st;
+    malloc_zone_statistics(nullptr, &st);
+    return st.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;
+#else
+    return (size_t)mallinfo().uordblks;
+#endif
+}
+
+static uint32_t count_children(lv_obj_t* obj) {
+    uint32_t n = lv_obj_get_child_cnt(obj);
+    uint32_t total = n;
+    for (uint32_t i = 0; i < n; i++) total += count_children(lv_obj_get_child(obj, i));
+    return total;
+}
+
+uint32_t bench_obj_count() {
+    return 2 + count_children(lv_scr_act()) + count_children(lv_layer_top());
+}
+
+void bench_report(const char* metric, double value, const char* unit) {
+    printf("  %-36s %12.2f %s\n", metric, value, unit);
+}
+
+static int check_failures = 0;
+
+void bench_check(const char* what, bool ok) {
+    printf("  %-36s %12s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) check_failures++;
+}
+
+// Pointer input backed by the mock GT911, registered once and shared
+static lv_indev_drv_t* bench_touch_indev(bool irq) {
+    static lv_indev_drv_t drv;
+    static bool registered = false;
+    if (registered) {
+        touch_reader_init(&drv, mock_touch_read, irq);
+        return &drv;
+    }
+    lv_indev_drv_init(&drv);
+    drv.type = LV_INDEV_TYPE_POINTER;
+    touch_reader_init(&drv, mock_touch_read, irq);
+    input_latency_attach_indev(&drv);
+    lv_indev_drv_register(&drv);
+    registered = true;
+    return &drv;
+}
+
+// ----- Scenarios -----
+
+static void bench_forecast_fmt(float celsius, bool fahrenheit, char* buf, size_t len) {
+    (void)fahrenheit;
+    snprintf(buf, len, "%.0f\xC2\xB0", celsius);
+}
+
+// Build the dashboard, then push changing snapshots through ui_update()
+static void scenario_ui_update() {
+    bench_fresh_screen();
+    size_t heap0 = bench_heap_used();
+    uint32_t objs0 = bench_obj_count();
+
+    printf("  layout mode: %s\n", UI_STATIC_LAYOUT ? "static" : "flex");
+    uint32_t t0 = micros();
+    ui_create();
+    lv_obj_update_layout(lv_scr_act());
+    bench_report("ui_create() + first layout", (micros() - t0) / 1000.0, "ms");
+
+    ui_set_wifi_status(true);
+    ui_show_loading(false);
+
+    bench_report("dashboard objects", bench_obj_count() - objs0, "");
+    bench_report("dashboard heap", (double)(bench_heap_used() - heap0) / 1024.0, "KiB");
+    bench_report("first paint", bench_refresh_us() / 1000.0, "ms");
+
+    const int N = 200;
+    uint64_t update_us = 0, layout_us = 0, refresh_us = 0;
+    int relayouts = 0;
+    redraw_stats_reset();
+    for (int i = 0; i < N; i++) {
+        HAWeatherData d = make_mock_data(i + 1);
+        t0 = micros();
+        ui_update(d);
+        update_us += micros() - t0;
+
+        // Run the layout pass the refresh would do, separately, to time it
+        lv_obj_t* scr = lv_scr_act();
+        if (scr->scr_layout_inv) relayouts++;
+        t0 = micros();
+        lv_obj_update_layout(scr);
+        layout_us += micros() - t0;
+
+        refresh_us += bench_refresh_us();
+    }
+
+    RedrawFrameStats fs;
+    redraw_stats_get_frame(fs);
+    bench_report("ui_update()", (double)update_us / N, "us/update");
+    bench_report("layout after update", (double)layout_us / N, "us/update");
+    bench_report("updates needing relayout", 100.0 * relayouts / N, "%");
+    bench_report("refresh after update", (double)refresh_us / N, "us/update");
+    bench_report("rendered px", fs.frames ? (double)fs.total_px / fs.frames : 0, "px/frame");
+
+    // Same again, letting the bar animations run to completion
+    const int N_ANIM = 10;
+    redraw_stats_reset();
+    for (int i = 0; i < N_ANIM; i++) {
+        ui_update(make_mock_data(i + 1));
+        bench_settle(300);
+    }
+    redraw_stats_get_frame(fs);
+    bench_report("animated update frames", (double)fs.frames / N_ANIM, "frames/update");
+    bench_report("animated update render", (double)fs.total_us / N_ANIM / 1000.0, "ms/update");
+}
+
+// Forecast strip memory vs entry count, and cost of one scroll step
+static void scenario_forecast() {
+    static HAForecastDay days[HA_FORECAST_MAX];
+    for (int i = 0; i < HA_FORECAST_MAX; i++) {
+        char name[8];
+        snprintf(name, sizeof(name), "%02d:00", i);
+        days[i] = {name, i % 2 ? "rainy" : "partlycloudy", 10.0f + i, 2.0f + i, true, true};
+    }
+
+    const uint16_t counts[] = {3, 7, HA_FORECAST_MAX};
+    for (uint16_t n : counts) {
+        bench_fresh_screen();
+        size_t heap0 = bench_heap_used();
+        uint32_t objs0 = bench_obj_count();
+
+        lv_obj_t* strip = forecast_strip_create(lv_scr_act(), bench_forecast_fmt);
+        forecast_strip_set_data(strip, days, n);
+        bench_refresh_us();
+
+        char metric[48];
+        snprintf(metric, sizeof(metric), "%u entries: objects", (unsigned)n);
+        bench_report(metric, bench_obj_count() - objs0, "");
+        snprintf(metric, sizeof(metric), "%u entries: heap", (unsigned)n);
+        bench_report(metric, (double)(bench_heap_used() - heap0), "B");
+
+        // Scroll across the whole strip in 8 px steps, rendering each step
+        const int STEP = 8;
+        int steps = 0;
+        uint64_t us = 0;
+        redraw_stats_reset();
+        while (lv_obj_get_scroll_right(strip) > 0) {
+            lv_obj_scroll_by(strip, -STEP, 0, LV_ANIM_OFF);
+            us += bench_refresh_us();
+            steps++;
+        }
+        if (steps > 0) {
+            snprintf(metric, sizeof(metric), "%u entries: scroll step", (unsigned)n);
+            bench_report(metric, (double)us / steps, "us/step");
+        }
+    }
+}
+
+// Spinner frames with the loading overlay up: old translucent overlay vs current
+static void loading_frames(lv_obj_t* overlay, lv_opa_t opa, const char* label) {
+    lv_obj_set_style_bg_opa(overlay, opa, 0);
+    bench_refresh_us();
+    redraw_stats_reset();
+    bench_settle(2000);
+
+    RedrawFrameStats fs;
+    redraw_stats_get_frame(fs);
+    char metric[48];
+    snprintf(metric, sizeof(metric), "%s: render", label);
+    bench_report(metric, fs.frames ? (double)fs.total_us / fs.frames : 0, "us/frame");
+    snprintf(metric, sizeof(metric), "%s: rendered px", label);
+    bench_report(metric, fs.frames ? (double)fs.total_px / fs.frames : 0, "px/frame");
+}
+
+static void scenario_loading() {
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(true);
+
+    // ui_create() adds the overlay to the screen last
+    lv_obj_t* overlay = lv_obj_get_child(lv_scr_act(), -1);
+    loading_frames(overlay, LV_OPA_80, "overlay opa 80 (old)");
+    loading_frames(overlay, UI_LOADING_OPA, "overlay opa UI_LOADING_OPA");
+}
+
+// Glyph rendering cost per font variant (subset vs compressed subset when
+// built with UI_SUBSET_FONTS, else the LVGL built-ins)
+#if UI_SUBSET_FONTS
+LV_FONT_DECLARE(ui_font_montserrat_20)
+LV_FONT_DECLARE(ui_font_montserrat_20_z)
+LV_FONT_DECLARE(ui_font_montserrat_40)
+LV_FONT_DECLARE(ui_font_montserrat_40_z)
+#endif
+
+static void scenario_fonts() {
+    static const struct {
+        const char*      name;
+        const lv_font_t* font;
+    } FONTS[] = {
+#if UI_SUBSET_FONTS
+        {"subset 20",            &ui_font_montserrat_20},
+        {"subset 20 compressed", &ui_font_montserrat_20_z},
+        {"subset 40",            &ui_font_montserrat_40},
+        {"subset 40 compressed", &ui_font_montserrat_40_z},
+#else
+        {"built-in 20",          &lv_font_montserrat_20},
+        {"built-in 40",          &lv_font_montserrat_40},
+#endif
+    };
+    static const char* TEXT = "-12.3\xC2\xB0" "C 45% Wed";
+
+    int glyphs = 0;
+    for (const char* p = TEXT; *p; p++) {
+        if ((*p & 0xC0) != 0x80 && *p != ' ') glyphs++;
+    }
+
+    for (const auto& f : FONTS) {
+        bench_fresh_screen();
+        lv_obj_t* label = lv_label_create(lv_scr_act());
+        lv_obj_set_style_text_font(label, f.font, 0);
+        lv_label_set_text(label, TEXT);
+        bench_refresh_us();
+
+        const int N = 200;
+        uint64_t us = 0;
+        for (int i = 0; i < N; i++) {
+            lv_obj_invalidate(label);
+            us += bench_refresh_us();
+        }
+
+        char metric[48];
+        snprintf(metric, sizeof(metric), "%s: label", f.name);
+        bench_report(metric, (double)us / N, "us/frame");
+        snprintf(metric, sizeof(metric), "%s: per glyph", f.name);
+        bench_report(metric, (double)us / N / glyphs, "us/glyph");
+    }
+}
+
+// Weather icon redraw: font glyph label vs pre-rendered icon_cache image
+static double icon_redraw_us(lv_obj_t* obj) {
+    bench_refresh_us();
+    const int N = 200;
+    uint64_t us = 0;
+    for (int i = 0; i < N; i++) {
+        lv_obj_invalidate(obj);
+        us += bench_refresh_us();
+    }
+    return (double)us / N;
+}
+
+static void scenario_icons() {
+    static const struct {
+        const char*      name;
+        const lv_font_t* font;
+    } SIZES[] = {
+        {"40px", UI_FONT_WEATHER_40},
+        {"24px", UI_FONT_WEATHER_24},
+    };
+    const lv_color_t tint = lv_color_hex(0xFBBF24);
+
+    bench_fresh_screen();
+    icon_cache_clear();
+    uint32_t t0 = micros();
+    for (const auto& sz : SIZES) icon_cache_prewarm(sz.font, tint);
+    bench_report("prewarm all icons", (micros() - t0) / 1000.0, "ms");
+    bench_report("cache size", icon_cache_bytes() / 1024.0, "KiB");
+
+    char metric[48];
+    for (const auto& sz : SIZES) {
+        bench_fresh_screen();
+        lv_obj_t* label = lv_label_create(lv_scr_act());
+        lv_obj_set_style_text_font(label, sz.font, 0);
+        lv_obj_set_style_text_color(label, tint, 0);
+        lv_label_set_text(label, ICON_WEATHER_PARTLY_CLOUDY);
+        snprintf(metric, sizeof(metric), "%s label (glyph)", sz.name);
+        bench_report(metric, icon_redraw_us(label), "us/frame");
+        lv_obj_del(label);
+
+        const lv_img_dsc_t* src = icon_cache_get(ICON_WEATHER_PARTLY_CLOUDY, sz.font, tint);
+        if (!src) {
+            printf("  icon cache disabled (UI_ICON_CACHE 0)\n");
+            continue;
+        }
+        lv_obj_t* img = lv_img_create(lv_scr_act());
+        lv_img_set_src(img, src);
+        snprintf(metric, sizeof(metric), "%s lv_img (cached)", sz.name);
+        bench_report(metric, icon_redraw_us(img), "us/frame");
+    }
+}
+
+// Idle dashboard: the old fixed 5 ms poll vs sleeping until the next timer.
+// Runs one stats window so event_loop's own wakeups/s and idle% are filled in.
+static void scenario_idle() {
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+    bench_settle(200);
+
+    const uint32_t run_ms = EVENT_LOOP_STATS_WINDOW_MS + 100;
+    uint32_t start = millis();
+    uint32_t iterations = 0;
+    uint64_t busy_us = 0;
+    std::clock_t cpu0 = std::clock();
+    while (millis() - start < run_ms) {
+        uint32_t t0 = micros();
+        lv_timer_handler();
+        busy_us += micros() - t0;
+        iterations++;
+        delay(5);
+    }
+    double elapsed_s = (millis() - start) / 1000.0;
+    double cpu_ms = (std::clock() - cpu0) * 1000.0 / CLOCKS_PER_SEC;
+    bench_report("poll 5 ms: wakeups", iterations / elapsed_s, "/s");
+    bench_report("poll 5 ms: idle", 100.0 - busy_us / (elapsed_s * 1e4), "%");
+    bench_report("poll 5 ms: cpu", cpu_ms / elapsed_s, "ms/s");
+
+    event_loop_init();
+    start = millis();
+    cpu0 = std::clock();
+    while (millis() - start < run_ms) event_loop_run_once();
+    elapsed_s = (millis() - start) / 1000.0;
+    cpu_ms = (std::clock() - cpu0) * 1000.0 / CLOCKS_PER_SEC;
+    EventLoopStats ls;
+    event_loop_get_stats(ls);
+    bench_report("event loop: wakeups", ls.wakeups_per_s, "/s");
+    bench_report("event loop: idle", ls.idle_pct, "%");
+    bench_report("event loop: cpu", cpu_ms / elapsed_s, "ms/s");
+}
+
+static void run_loop_ms(uint32_t ms) {
+    uint32_t start = millis();
+    while (millis() - start < ms) event_loop_run_once();
+}
+
+static uint32_t touch_clicks = 0;
+
+static void touch_click_cb(lv_event_t* e) {
+    (void)e;
+    touch_clicks++;
+}
+
+// Mock GT911 behind the touch reader: I2C reads while idle (polling vs INT),
+// then scripted tap and flick gestures through the INT-driven state machine
+static void scenario_touch() {
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+
+    bench_touch_indev(false);
+    event_loop_init();
+
+    const uint32_t idle_ms = 3000;
+    for (bool irq : {false, true}) {
+        bench_touch_indev(irq);
+        run_loop_ms(200);
+        uint32_t reads0 = mock_touch_reads();
+        EventLoopStats ls0, ls1;
+        event_loop_get_stats(ls0);
+        run_loop_ms(idle_ms);
+        event_loop_get_stats(ls1);
+        const char* mode = irq ? "INT" : "poll";
+        char metric[64];
+        snprintf(metric, sizeof(metric), "%s: idle I2C reads", mode);
+        bench_report(metric, (mock_touch_reads() - reads0) * 60000.0 / idle_ms, "/min");
+        snprintf(metric, sizeof(metric), "%s: idle loop wakeups", mode);
+        bench_report(metric, (ls1.wakeups - ls0.wakeups) * 1000.0 / idle_ms, "/s");
+    }
+
+    // Tap a button: exactly one click, then back to zero reads
+    lv_obj_t* btn = lv_obj_create(lv_layer_top());
+    lv_obj_set_pos(btn, 300, 200);
+    lv_obj_set_size(btn, 200, 80);
+    lv_obj_add_event_cb(btn, touch_click_cb, LV_EVENT_CLICKED, nullptr);
+    touch_clicks = 0;
+    uint32_t reads0 = mock_touch_reads();
+    mock_touch_set(true, 400, 240);
+    run_loop_ms(80);
+    mock_touch_set(false, 0, 0);
+    run_loop_ms(100);
+    bench_report("INT: tap clicks (expect 1)", touch_clicks, "");
+    bench_report("INT: tap I2C reads", mock_touch_reads() - reads0, "");
+    lv_obj_del(btn);
+
+    // Flick a scrollable row: the reader must stay awake while the scroll
+    // coasts, then go idle again
+    lv_obj_t* row = lv_obj_create(lv_layer_top());
+    lv_obj_set_pos(row, 0, 200);
+    lv_obj_set_size(row, SCREEN_WIDTH, 100);
+    lv_obj_t* content = lv_obj_create(row);
+    lv_obj_set_size(content, SCREEN_WIDTH * 4, 60);
+    lv_obj_update_layout(row);
+    reads0 = mock_touch_reads();
+    for (int x = 700; x >= 300; x -= 40) {
+        mock_touch_set(true, x, 250);
+        run_loop_ms(10);
+    }
+    mock_touch_set(false, 0, 0);
+    lv_coord_t released_at = lv_obj_get_scroll_x(row);
+    run_loop_ms(1500);
+    bench_report("INT: flick coast after release", lv_obj_get_scroll_x(row) - released_at, "px");
+    bench_report("INT: flick I2C reads", mock_touch_reads() - reads0, "");
+    reads0 = mock_touch_reads();
+    run_loop_ms(1000);
+    bench_report("INT: reads 1 s after flick (expect 0)", mock_touch_reads() - reads0, "");
+    lv_obj_del(row);
+
+    TouchReaderStats ts;
+    touch_reader_get_stats(ts);
+    bench_report("INT: timer resumes from idle", ts.resumes, "");
+
+    // Leave polling on for scenarios that follow
+    bench_touch_indev(false);
+}
+
+// Tiered LVGL allocator: randomized alloc/free/realloc integrity check,
+// alloc+free cost against the system heap, and pool usage for the dashboard
+static void scenario_alloc() {
+    struct Block {
+        uint8_t* p;
+        size_t   n;
+        uint8_t  fill;
+    };
+    std::vector<Block> live;
+    srand(1);
+    uint32_t errors = 0;
+    auto check = [&](const Block& b, size_t n) {
+        for (size_t k = 0; k < n; k++) {
+            if (b.p[k] != b.fill) {
+                errors++;
+                return;
+            }
+        }
+    };
+    // Mostly small blocks like LVGL's, some label text / image sized ones
+    auto rand_size = [] { return (size_t)(rand() % 4 ? rand() % (TIERED_POOL_MAX + 8) : rand() % 4096); };
+    for (int i = 0; i < 100000; i++) {
+        int op = live.empty() ? 0 : rand() % 3;
+        if (op == 0) {
+            Block b = {nullptr, rand_size(), (uint8_t)rand()};
+            b.p = (uint8_t*)tiered_malloc(b.n);
+            memset(b.p, b.fill, b.n);
+            live.push_back(b);
+        } else if (op == 1) {
+            size_t i = rand() % live.size();
+            check(live[i], live[i].n);
+            tiered_free(live[i].p);
+            live[i] = live.back();
+            live.pop_back();
+        } else {
+            Block& b = live[rand() % live.size()];
+            size_t n = rand_size() + 1;
+            b.p = (uint8_t*)tiered_realloc(b.p, n);
+            check(b, n < b.n ? n : b.n);
+            b.n = n;
+            memset(b.p, b.fill, b.n);
+        }
+    }
+    for (const Block& b : live) tiered_free(b.p);
+    bench_report("integrity errors (expect 0)", errors, "");
+
+    // Alloc+free pairs with a batch of live blocks, LVGL-like sizes
+    static const size_t SIZES[] = {12, 16, 20, 24, 32, 40, 48, 64, 80, 96, 128, 200};
+    const int N = 256, ROUNDS = 200;
+    void* ptrs[N];
+    for (int heap = 0; heap < 2; heap++) {
+        uint32_t t0 = bench_now_us();
+        for (int r = 0; r < ROUNDS; r++) {
+            for (int i = 0; i < N; i++) {
+                size_t n = SIZES[(i + r) % 12];
+                ptrs[i] = heap ? malloc(n) : tiered_malloc(n);
+            }
+            for (int i = 0; i < N; i++) {
+                if (heap) free(ptrs[i]);
+                else tiered_free(ptrs[i]);
+            }
+        }
+        bench_report(heap ? "malloc+free" : "tiered malloc+free",
+                     (bench_now_us() - t0) * 1000.0 / (N * ROUNDS), "ns/pair");
+    }
+
+    // Pool usage with the dashboard built
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+    bench_refresh_us();
+    tiered_stats_t st;
+    tiered_alloc_get_stats(&st);
+    uint32_t pooled = 0, overflows = 0;
+    for (const tiered_class_stats_t& c : st.classes) {
+        pooled += c.used;
+        overflows += c.overflows;
+    }
+    bench_report("dashboard: pool blocks", pooled, "");
+    bench_report("dashboard: pool bytes", st.pool_used, "B");
+    bench_report("dashboard: pool waste", st.pool_waste_pct, "%");
+    bench_report("dashboard: bulk blocks", st.bulk_live, "");
+    bench_report("dashboard: bulk bytes", st.bulk_used, "B");
+    bench_report("overflows to bulk (total)", overflows, "");
+    tiered_alloc_dump();
+}
+
+// Performance HUD: an update should redraw only inside the HUD box (330x104)
+static void scenario_hud() {
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+    bench_refresh_us();
+
+    perf_hud_toggle();
+    uint32_t show_us = bench_refresh_us();
+    bench_report("show", show_us, "us");
+
+    RedrawFrameStats fs;
+    uint32_t total_us = 0, total_px = 0;
+    const int N = 20;
+    for (int i = 0; i < N; i++) {
+        perf_hud_update();
+        total_us += bench_refresh_us();
+        redraw_stats_get_frame(fs);
+        total_px += fs.last_px;
+    }
+    bench_report("update + refresh", (double)total_us / N, "us");
+    bench_report("rendered px per update", (double)total_px / N, "px");
+    perf_hud_toggle();
+}
+
+static void empty_timer_cb(lv_timer_t* timer) {
+    (void)timer;
+}
+
+// Callback profiler: trampoline overhead, then a profile of the dashboard
+// under periodic updates and the loading spinner
+static void scenario_profile() {
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+    bench_refresh_us();
+
+    // Overhead: one always-ready timer, lv_timer_handler() in a tight loop
+    lv_timer_t* t = lv_timer_create(empty_timer_cb, 0, nullptr);
+    const int N = 20000;
+    double per_call[2];
+    for (int on = 0; on < 2; on++) {
+        profiler_set_enabled(on);
+        uint32_t t0 = bench_now_us();
+        for (int i = 0; i < N; i++) lv_timer_handler();
+        per_call[on] = (bench_now_us() - t0) * 1000.0 / N;
+    }
+    lv_timer_del(t);
+    bench_report("lv_timer_handler, profiler off", per_call[0], "ns");
+    bench_report("lv_timer_handler, profiler on", per_call[1], "ns");
+
+    profiler_reset();
+    event_loop_init();
+    uint32_t start = millis();
+    int step = 0;
+    while (millis() - start < 3000) {
+        uint32_t t0 = millis();
+        ui_show_loading(step % 4 == 3);
+        ui_update(make_mock_data(++step));
+        while (millis() - t0 < 250) {
+            profiler_scan();
+            event_loop_run_once();
+        }
+    }
+    ui_show_loading(false);
+    profiler_dump();
+    profiler_set_enabled(false);
+}
+
+// Depth-first search for buttons (the status bar toggles)
+static void find_buttons(lv_obj_t* obj, lv_obj_t** out, int max, int& n) {
+    if (n < max && lv_obj_check_type(obj, &lv_btn_class)) out[n++] = obj;
+    for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++) find_buttons(lv_obj_get_child(obj, i), out, max, n);
+}
+
+static void busy_timer_cb(lv_timer_t* timer) {
+    delay((uintptr_t)timer->user_data);   // stands in for a blocking HA fetch
+}
+
+// Touch-to-photon latency of scripted taps on the unit and theme toggles:
+// polled vs INT-driven touch, idle vs right behind a blocking poll.
+// Idle latency above the budget fails the bench.
+static void scenario_latency() {
+    const uint32_t IDLE_BUDGET_MS = 100;
+    const uint32_t BUSY_MS = 300;
+    const int TAPS = 10;
+
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(false);
+    bench_refresh_us();
+
+    lv_obj_t* btns[2];
+    int found = 0;
+    find_buttons(lv_scr_act(), btns, 2, found);
+    bench_check("found unit and theme toggles", found == 2);
+    if (found != 2) return;
+
+    lv_timer_t* busy = lv_timer_create(busy_timer_cb, 1000000, (void*)(uintptr_t)BUSY_MS);
+    lv_timer_pause(busy);
+    event_loop_init();
+
+    static const char* const NAMES[2] = {"unit", "theme"};
+    for (int mode = 0; mode < 3; mode++) {
+        bool irq = mode != 0;
+        bool after_poll = mode == 2;
+        bench_touch_indev(irq);
+        run_loop_ms(100);
+
+        for (int b = 0; b < 2; b++) {
+            lv_area_t c;
+            lv_obj_get_coords(btns[b], &c);
+            lv_coord_t x = (c.x1 + c.x2) / 2, y = (c.y1 + c.y2) / 2;
+
+            input_latency_reset();
+            for (int i = 0; i < TAPS; i++) {
+                mock_touch_set(true, x, y);
+                run_loop_ms(60);
+                mock_touch_set(false, x, y);
+                if (after_poll) {
+                    lv_timer_resume(busy);
+                    lv_timer_ready(busy);   // newest timer runs first: blocks before the indev read
+                }
+                run_loop_ms(after_poll ? BUSY_MS + 200 : 200);
+                lv_timer_pause(busy);
+            }
+            InputLatencyStats st;
+            input_latency_get(st);
+
+            char metric[64];
+            const char* label = mode == 0 ? "poll" : (after_poll ? "INT, after poll" : "INT");
+            snprintf(metric, sizeof(metric), "%s %s: avg", label, NAMES[b]);
+            bench_report(metric, st.samples ? st.total_us / 1000.0 / st.samples : 0, "ms");
+            snprintf(metric, sizeof(metric), "%s %s: max", label, NAMES[b]);
+            bench_report(metric, st.max_us / 1000.0, "ms");
+            snprintf(metric, sizeof(metric), "%s %s: clicks timed", label, NAMES[b]);
+            bench_report(metric, st.samples, "");
+            if (!after_poll) {
+                snprintf(metric, sizeof(metric), "%s %s: max < %lu ms", label, NAMES[b], (unsigned long)IDLE_BUDGET_MS);
+                bench_check(metric, st.samples == TAPS && st.max_us < IDLE_BUDGET_MS * 1000);
+            }
+            if (b == 1 && mode == 2) input_latency_dump();
+        }
+    }
+
+    // Taps on the dashboard itself redraw nothing and are not followed, so
+    // the next HUD or data refresh cannot pass for their photon
+    input_latency_reset();
+    for (int i = 0; i < TAPS; i++) {
+        mock_touch_set(true, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+        run_loop_ms(60);
+        mock_touch_set(false, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+        lv_obj_invalidate(lv_scr_act());   // an unrelated redraw right after
+        run_loop_ms(200);
+    }
+    InputLatencyStats st;
+    input_latency_get(st);
+    bench_check("untracked taps not timed", st.samples == 0 && st.no_redraw == 0);
+    lv_timer_del(busy);
+    bench_touch_indev(false);
+}
+
+// Unit toggle: swapping the precomputed C/F strings vs re-running ui_update()
+// (what the toggle used to do). Fails unless the swap redraws less.
+static void scenario_units() {
+    bench_fresh_screen();
+    ui_create();
+    HAWeatherData d = make_mock_data(1);
+    ui_update(d);
+    ui_show_loading(false);
+    bench_refresh_us();
+
+    lv_obj_t* btns[2];
+    int found = 0;
+    find_buttons(lv_scr_act(), btns, 2, found);
+    bench_check("found unit toggle", found >= 1);
+    if (found < 1) return;
+
+    const int N = 50;
+    static const char* const LABELS[2] = {"swap strings", "ui_update (old toggle)"};
+    double px[2];
+    for (int full = 0; full < 2; full++) {
+        uint64_t toggle_us = 0, refresh_us = 0, total_px = 0;
+        RedrawFrameStats fs;
+        for (int i = 0; i < N; i++) {
+            uint32_t t0 = micros();
+            lv_event_send(btns[0], LV_EVENT_CLICKED, nullptr);
+            if (full) ui_update(d);
+            toggle_us += micros() - t0;
+            refresh_us += bench_refresh_us();
+            redraw_stats_get_frame(fs);
+            total_px += fs.last_px;
+        }
+        px[full] = (double)total_px / N;
+
+        char metric[64];
+        snprintf(metric, sizeof(metric), "%s: toggle", LABELS[full]);
+        bench_report(metric, (double)toggle_us / N, "us");
+        snprintf(metric, sizeof(metric), "%s: refresh", LABELS[full]);
+        bench_report(metric, (double)refresh_us / N, "us");
+        snprintf(metric, sizeof(metric), "%s: rendered px", LABELS[full]);
+        bench_report(metric, px[full], "px");
+    }
+    bench_check("swap redraws less than ui_update", px[0] < px[1]);
+}
+
+// num_fmt against snprintf: same text for a stride over every float bit
+// pattern (all exponents, subnormals, inf, nan), every float in [64, 128)
+// and every multiple of 1/1024 in [-300, 300] (all the exact ties), then
+// the cost of both on dashboard-style values
+static bool fmt_matches(float v, int decimals, long& mismatches) {
+    char a[64], b[64];
+    num_fmt_fixed(a, sizeof(a), v, decimals);
+    snprintf(b, sizeof(b), "%.*f", decimals, (double)v);
+    if (strcmp(a, b) == 0) return true;
+    if (mismatches++ < 5) printf("  mismatch: %.9g %%.%df: \"%s\" vs \"%s\"\n", (double)v, decimals, a, b);
+    return false;
+}
+
+static void scenario_fmt() {
+    long checked = 0, mismatches = 0;
+    uint32_t t0 = micros();
+    for (uint64_t bits = 0; bits <= UINT32_MAX; bits += 4093) {
+        uint32_t u = (uint32_t)bits;
+        float v;
+        memcpy(&v, &u, sizeof(v));
+        for (int d = 0; d <= NUM_FMT_MAX_DECIMALS; d++, checked++) fmt_matches(v, d, mismatches);
+    }
+    for (float v = 64.0f; v < 128.0f; v = nextafterf(v, 256.0f), checked++) fmt_matches(v, 1, mismatches);
+    for (int i = -300 * 1024; i <= 300 * 1024; i++) {
+        for (int d = 0; d <= NUM_FMT_MAX_DECIMALS; d++, checked++) fmt_matches(i / 1024.0f, d, mismatches);
+    }
+    static const float SPECIAL[] = {0.0f, -0.0f, -0.04f, -0.05f, 0.05f, 0.25f, -0.25f, 2.5f, 3.5f};
+    for (float v : SPECIAL) {
+        for (int d = 0; d <= NUM_FMT_MAX_DECIMALS; d++, checked++) fmt_matches(v, d, mismatches);
+    }
+    bench_report("values checked", (double)checked, "");
+    bench_report("check time", (micros() - t0) / 1e6, "s");
+
+    char a[16], b[16];
+    size_t na = num_fmt_value(a, sizeof(a), "T ", -12.25f, 1, NUM_FMT_DEG "C");
+    int nb = snprintf(b, sizeof(b), "T %.1f" NUM_FMT_DEG "C", -12.25f);
+    char ta[6], tb[6];
+    num_fmt_value(ta, sizeof(ta), "T ", -12.25f, 1, NUM_FMT_DEG "C");
+    snprintf(tb, sizeof(tb), "T %.1f" NUM_FMT_DEG "C", -12.25f);
+    bench_check("prefix/suffix and truncation", strcmp(a, b) == 0 && (int)na == nb && strcmp(ta, tb) == 0);
+    bench_check("identical to snprintf", mismatches == 0);
+
+    // Dashboard-like inputs: temperatures, wind, humidity
+    const int N = 200000;
+    volatile size_t sink = 0;
+    char buf[32];
+    t0 = micros();
+    for (int i = 0; i < N; i++) {
+        sink += snprintf(buf, sizeof(buf), "%.1f" NUM_FMT_DEG "C", -20.0f + (i % 1000) * 0.1f);
+    }
+    double printf_ns = (micros() - t0) * 1000.0 / N;
+    t0 = micros();
+    for (int i = 0; i < N; i++) {
+        sink += num_fmt_value(buf, sizeof(buf), nullptr, -20.0f + (i % 1000) * 0.1f, 1, NUM_FMT_DEG "C");
+    }
+    double fmt_ns = (micros() - t0) * 1000.0 / N;
+    (void)sink;
+    bench_report("snprintf(\"%.1f\")", printf_ns, "ns/call");
+    bench_report("num_fmt_value(.., 1, ..)", fmt_ns, "ns/call");
+}
+
+// Temperature history: ring bookkeeping, put cost, and a new sample on a
+// standalone card redrawing only its sparkline
+static void scenario_history() {
+    const uint32_t T0 = 1700000000 / TEMP_HISTORY_INTERVAL_S * TEMP_HISTORY_INTERVAL_S;
+    const TempHistory* h = temp_history_get(TEMP_OUTDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+
+    // 300 slots of a daily sine: the first 12 fall out of the window
+    auto sample = [](int i) { return 5.0f + 8.0f * sinf(i * 6.2831853f / TEMP_HISTORY_SLOTS); };
+    for (int i = 0; i < 300; i++) temp_history_put(TEMP_OUTDOOR, T0 + i * TEMP_HISTORY_INTERVAL_S, sample(i));
+    int16_t lo = INT16_MAX, hi = INT16_MIN;
+    for (int i = 12; i < 300; i++) {
+        int16_t v = (int16_t)lroundf(sample(i) * 10.0f);
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+    bench_check("window holds the newest 288 slots", h->samples == TEMP_HISTORY_SLOTS &&
+                temp_history_at(h, TEMP_HISTORY_SLOTS - 1) == (int16_t)lroundf(sample(299) * 10.0f));
+    bench_check("min/max tracked", h->min == lo && h->max == hi);
+    bool too_old = temp_history_put(TEMP_OUTDOOR, T0, 50.0f);
+    uint32_t t_gap = T0 + 302 * TEMP_HISTORY_INTERVAL_S;
+    temp_history_put(TEMP_OUTDOOR, t_gap, 6.0f);
+    bool backfilled = temp_history_put(TEMP_OUTDOOR, t_gap - TEMP_HISTORY_INTERVAL_S, 6.5f);
+    bench_check("gaps, late fill-in, stale reject", !too_old && backfilled &&
+                temp_history_at(h, TEMP_HISTORY_SLOTS - 2) == 65 &&
+                temp_history_at(h, TEMP_HISTORY_SLOTS - 3) == TEMP_HISTORY_GAP);
+    bench_report("memory per sensor", sizeof(TempHistory), "bytes");
+
+    const int N = 100000;
+    uint32_t t0 = micros();
+    for (int i = 0; i < N; i++) {
+        temp_history_put(TEMP_INDOOR, T0 + (i / 10) * TEMP_HISTORY_INTERVAL_S, 21.0f + (i % 50) * 0.1f);
+    }
+    bench_report("temp_history_put()", (micros() - t0) * 1000.0 / N, "ns");
+    temp_history_clear(TEMP_INDOOR);
+
+    bench_fresh_screen();
+    lv_obj_t* card = therm_card_create(lv_scr_act(), "OUTDOOR");
+    lv_obj_set_size(card, LEFT_PANEL_W - 12, THERM_CARD_H);
+    therm_card_set_range(card, -20, 40);
+    therm_card_set_value(card, 6.0f, lv_color_hex(0x22C55E), false);
+    therm_card_set_text(card, "6.0" NUM_FMT_DEG "C");
+    therm_card_set_history(card, h);
+    bench_refresh_us();
+
+    RedrawFrameStats fs;
+    uint64_t refresh_us = 0, px = 0;
+    const int STEPS = 50;
+    for (int i = 0; i < STEPS; i++) {
+        if (temp_history_put(TEMP_OUTDOOR, t_gap + (i + 1) * TEMP_HISTORY_INTERVAL_S, sample(i))) {
+            therm_card_history_changed(card);
+        }
+        refresh_us += bench_refresh_us();
+        redraw_stats_get_frame(fs);
+        px += fs.last_px;
+    }
+    bench_report("new sample: refresh", (double)refresh_us / STEPS, "us");
+    bench_report("new sample: rendered px", (double)px / STEPS, "px");
+    bench_check("only the sparkline redraws", px > 0 && px / STEPS < (LEFT_PANEL_W - 12) * THERM_CARD_H / 4);
+    temp_history_clear(TEMP_OUTDOOR);
+}
+
+// History backfill: stream a 10k-point 24 h fixture through the parser in
+// network-sized chunks into the indoor/outdoor rings
+static void run_backfill(const std::string& json, uint32_t now_s, size_t chunk, HistoryBackfillStats* stats) {
+    temp_history_clear(TEMP_INDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+    HistoryBackfill b;
+    history_backfill_begin(b, now_s);
+    history_backfill_add(b, HA_ENTITY_INDOOR_TEMP, TEMP_INDOOR);
+    history_backfill_add(b, HA_ENTITY_OUTDOOR_TEMP, TEMP_OUTDOOR);
+    for (size_t off = 0; off < json.size(); off += chunk) {
+        history_backfill_feed(b, json.data() + off, std::min(chunk, json.size() - off));
+    }
+    history_backfill_end(b);
+    if (stats) *stats = b.stats;
+}
+
+static void scenario_backfill() {
+    const uint32_t NOW = 1700000000;
+    const int POINTS = 10000;
+    int unavailable = 0;
+    std::string json = make_mock_history(NOW, POINTS, &unavailable);
+    bench_report("fixture", json.size() / 1024.0, "KiB");
+    bench_check("ISO 8601 with offset", history_parse_time("2023-11-14T22:13:20.5+01:30") == NOW - 5400 &&
+                history_parse_time("2023-11-14T22:13:20Z") == NOW && history_parse_time("bogus") == 0);
+
+    HistoryBackfillStats st;
+    size_t heap0 = bench_heap_used();
+    const int RUNS = 10;
+    uint32_t t0 = micros();
+    for (int i = 0; i < RUNS; i++) run_backfill(json, NOW, 512, &st);
+    double us = (double)(micros() - t0) / RUNS;
+    bench_report("parse + downsample", us / 1000.0, "ms");
+    bench_report("throughput", json.size() / us, "MB/s");
+    bench_report("per point", us * 1000.0 / POINTS, "ns");
+    bench_report("parser state", sizeof(HistoryBackfill), "bytes");
+    bench_report("slots written", st.slots, "");
+    bench_check("no heap allocation", bench_heap_used() == heap0);
+    bench_check("points parsed, unavailable skipped",
+                st.points == (uint32_t)(POINTS - unavailable) && st.skipped == (uint32_t)unavailable);
+
+    // Every slot but the live one filled, close to the generating curve
+    TempHistory stream_result[2];
+    bool filled = true, close = true;
+    for (int e = 0; e < 2; e++) {
+        const TempHistory* h = temp_history_get(e ? TEMP_OUTDOOR : TEMP_INDOOR);
+        stream_result[e] = *h;
+        filled &= h->samples == TEMP_HISTORY_SLOTS - 1;
+        for (int age = 0; age < TEMP_HISTORY_SLOTS - 1; age++) {
+            int16_t v = temp_history_at(h, TEMP_HISTORY_SLOTS - 1 - age);
+            uint32_t mid = (h->newest_slot - age) * TEMP_HISTORY_INTERVAL_S + TEMP_HISTORY_INTERVAL_S / 2;
+            if (v == TEMP_HISTORY_GAP || fabsf(v / 10.0f - mock_history_value(e, mid)) > 0.5f) close = false;
+        }
+    }
+    bench_check("287 slots per sensor", filled);
+    bench_check("values follow the recorded curve", close);
+
+    // Chunk boundaries anywhere (inside strings, escapes, timestamps) change nothing
+    run_backfill(json, NOW, 1, nullptr);
+    bool same = memcmp(&stream_result[0], temp_history_get(TEMP_INDOOR), sizeof(TempHistory)) == 0 &&
+                memcmp(&stream_result[1], temp_history_get(TEMP_OUTDOOR), sizeof(TempHistory)) == 0;
+    bench_check("1-byte chunks give the same result", same);
+    temp_history_clear(TEMP_INDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+}
+
+// Flash sample log on a temp file: a week of 3 sensors every 30 s, range
+// scans, remount, wraparound wear and a record cut short by a reset
+struct TsCollect {
+    std::vector<std::pair<uint32_t, int32_t>> samples;
+};
+
+static void ts_collect(void* ctx, uint32_t t, int32_t v) {
+    ((TsCollect*)ctx)->samples.push_back({t, v});
+}
+
+static void ts_count(void* ctx, uint32_t t, int32_t v) {
+    (void)t;
+    (void)v;
+    (*(uint32_t*)ctx)++;
+}
+
+static int32_t ts_mock_value(int series, uint32_t t) {
+    return (int32_t)lroundf(mock_history_value(series % 2, t) * 10.0f) + series * 400;
+}
+
+// Offset of the free space in the newest sector, walking the length bytes
+static long ts_file_tail(const char* path) {
+    FILE* f = fopen(path, "rb");
+    std::vector<uint8_t> img(TS_STORE_SIM_SIZE);
+    size_t n = fread(img.data(), 1, img.size(), f);
+    fclose(f);
+    long best = -1;
+    uint32_t best_seq = 0;
+    for (size_t off = 0; off + TS_STORE_SECTOR <= n; off += TS_STORE_SECTOR) {
+        uint32_t magic, seq;
+        memcpy(&magic, &img[off], 4);
+        memcpy(&seq, &img[off + 4], 4);
+        if (magic == 0x42445354u && seq >= best_seq) {
+            best = (long)off;
+            best_seq = seq;
+        }
+    }
+    long p = best + 16;
+    while (img[p] != 0xFF) p += 1 + img[p];
+    return p;
+}
+
+static void scenario_tsdb() {
+    const char* path = "/tmp/bench_tsdb.bin";
+    const uint32_t T0 = 1700000000;
+    const int SERIES = 3, STEP = 30, DAYS = 7;
+    const uint32_t N = DAYS * 86400 / STEP;
+    unlink(path);
+    if (!ts_store_open_file(path, TS_STORE_SIM_SIZE)) {
+        bench_check("open store file", false);
+        return;
+    }
+
+    uint32_t t0 = micros();
+    bool ok = true;
+    for (uint32_t i = 0; i < N; i++) {
+        for (int s = 0; s < SERIES; s++) ok &= ts_store_append(s, T0 + i * STEP, ts_mock_value(s, T0 + i * STEP));
+    }
+    double append_us = (double)(micros() - t0) / (N * SERIES);
+    TsStoreStats st;
+    ts_store_get_stats(st);
+    bench_check("week of 3 series appended", ok && st.records == N * SERIES);
+    bench_report("append", append_us * 1000.0, "ns");
+    bench_report("bytes per record", (double)st.bytes_used / st.records, "");
+    bench_report("capacity at this rate", (double)st.sectors * TS_STORE_SECTOR / st.bytes_used * DAYS, "days");
+    // Flash only sees whole pages (plus each sector's tail when it rotates)
+    // and one erase per sector started: each of them stalls the display cache
+    bench_report("flash writes per hour", st.flash_writes / (DAYS * 24.0), "");
+    bench_check("whole pages programmed", st.flash_writes <= st.bytes_used / TS_STORE_PAGE + st.sectors_used &&
+                                          st.flash_erases <= st.sectors_used && st.unflushed < TS_STORE_PAGE);
+
+    // Full scan of one series and the last 24 h
+    TsCollect all;
+    t0 = micros();
+    ts_store_scan(1, 0, UINT32_MAX, ts_collect, &all);
+    double full_us = micros() - t0;
+    bool exact = all.samples.size() == N;
+    for (uint32_t i = 0; exact && i < N; i++) {
+        exact = all.samples[i].first == T0 + i * STEP && all.samples[i].second == ts_mock_value(1, T0 + i * STEP);
+    }
+    bench_check("scan returns every sample in order", exact);
+    bench_report("full scan (1 series)", full_us / 1000.0, "ms");
+    bench_report("decode throughput", (double)st.records / full_us, "Mrec/s");
+
+    const uint32_t last = T0 + (N - 1) * STEP;
+    uint32_t day = 0;
+    t0 = micros();
+    uint32_t visited = ts_store_scan(0, last - 86400 + 1, last, ts_count, &day);
+    bench_report("last 24 h scan", micros() - t0, "us");
+    bench_check("24 h window", visited == day && day == 86400 / STEP);
+
+    // Remount: same write position and delta bases
+    ts_store_close();
+    ts_store_open_file(path, TS_STORE_SIM_SIZE);
+    ts_store_append(2, last + STEP, 123);
+    TsCollect tail;
+    ts_store_scan(2, last, UINT32_MAX, ts_collect, &tail);
+    TsStoreStats st2;
+    ts_store_get_stats(st2);
+    bench_check("remount continues the log", st2.records == st.records + 1 && tail.samples.size() == 2 &&
+                tail.samples[1].first == last + STEP && tail.samples[1].second == 123);
+
+    // Record cut short after its length byte, then a garbage length byte
+    ts_store_close();
+    FILE* f = fopen(path, "r+b");
+    const uint8_t torn[] = {6, 0, 0x80, 0x80};
+    fseek(f, ts_file_tail(path), SEEK_SET);
+    fwrite(torn, 1, sizeof(torn), f);
+    fclose(f);
+    ts_store_open_file(path, TS_STORE_SIM_SIZE);
+    ts_store_append(0, last + 2 * STEP, 77);
+    ts_store_close();
+    f = fopen(path, "r+b");
+    const uint8_t garbage = 0;
+    fseek(f, ts_file_tail(path), SEEK_SET);
+    fwrite(&garbage, 1, 1, f);
+    fclose(f);
+    ts_store_open_file(path, TS_STORE_SIM_SIZE);
+    ts_store_append(0, last + 3 * STEP, 78);
+    TsCollect recovered;
+    ts_store_scan(0, last - STEP, UINT32_MAX, ts_collect, &recovered);
+    bench_check("torn writes skipped, appends continue", recovered.samples.size() == 4 &&
+                recovered.samples[2].second == 77 && recovered.samples[3].second == 78);
+    ts_store_close();
+
+    // Small store wrapped many times: newest data kept, erases spread evenly
+    unlink(path);
+    const size_t SMALL = 16 * TS_STORE_SECTOR;
+    ts_store_open_file(path, SMALL);
+    const uint32_t M = 200000;
+    for (uint32_t i = 0; i < M; i++) ts_store_append(0, T0 + i * STEP, (int32_t)(i % 1000));
+    TsStoreStats ws;
+    ts_store_get_stats(ws);
+    TsCollect kept;
+    ts_store_scan(0, 0, UINT32_MAX, ts_collect, &kept);
+    bool contiguous = !kept.samples.empty() && kept.samples.back().first == T0 + (M - 1) * STEP;
+    for (size_t i = 1; contiguous && i < kept.samples.size(); i++) {
+        contiguous = kept.samples[i].first == kept.samples[i - 1].first + STEP;
+    }
+    bench_report("wrapped: erases per sector", ws.erase_max, "");
+    bench_check("wrap keeps the newest, contiguous", contiguous && kept.samples.size() == ws.records);
+    bench_check("erase counts within 1", ws.erase_max - ws.erase_min <= 1);
+    ts_store_close();
+    unlink(path);
+}
+
+// Triple buffer under contention: a producer thread publishing as fast as it
+// can, a consumer verifying every snapshot it fetches is whole and newer
+struct SnapshotPayload {
+    uint32_t generation;
+    uint32_t words[63];   // 256 bytes, every word derived from the generation
+    String   text;        // heap-backed, like the String fields of HAWeatherData
+};
+
+static uint32_t snapshot_word(uint32_t gen, int i) {
+    return gen * 2654435761u + i;
+}
+
+static void scenario_snapshot() {
+    static TripleBuffer<SnapshotPayload> tb;
+    const uint32_t RUN_MS = 500;
+    std::atomic<bool> stop(false);
+    std::atomic<uint32_t> produced(0);
+
+    std::thread producer([&]() {
+        uint32_t g = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            SnapshotPayload& p = tb.back();
+            p.generation = g + 1;
+            for (int i = 0; i < 63; i++) p.words[i] = snapshot_word(g + 1, i);
+            p.text = std::to_string(g + 1);
+            g = tb.publish();
+            std::this_thread::yield();   // interleave even on a single core
+        }
+        produced.store(g);
+    });
+
+    uint32_t fetched = 0, torn = 0, reordered = 0, polls = 0, last = 0;
+    uint32_t t0 = millis();
+    while (millis() - t0 < RUN_MS) {
+        polls++;
+        if (!tb.fetch()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const SnapshotPayload& p = tb.front();
+        bool whole = p.generation == tb.generation() && p.text == std::to_string(p.generation).c_str();
+        for (int i = 0; whole && i < 63; i++) whole = p.words[i] == snapshot_word(p.generation, i);
+        torn += !whole;
+        reordered += tb.generation() <= last;
+        last = tb.generation();
+        fetched++;
+    }
+    stop = true;
+    producer.join();
+    tb.fetch();
+    bool final_ok = tb.generation() == produced.load() && tb.front().generation == produced.load();
+
+    bench_report("published", produced.load(), "");
+    bench_report("fetched", fetched, "");
+    bench_report("skipped by the consumer", produced.load() - fetched, "");
+    bench_report("consumer polls", polls, "");
+    bench_check("snapshots whole", fetched > 0 && torn == 0);
+    bench_check("generations strictly increase", reordered == 0);
+    bench_check("last publish is fetched", final_ok);
+
+    // Uncontended cost of the exchange itself
+    TripleBuffer<uint32_t> small;
+    const int N = 1000000;
+    uint32_t us = micros();
+    for (int i = 0; i < N; i++) {
+        small.back() = i;
+        small.publish();
+        small.fetch();
+    }
+    us = micros() - us;
+    bench_report("publish + fetch", us * 1000.0 / N, "ns");
+    bench_check("single thread round trip", small.front() == (uint32_t)(N - 1) && small.generation() == (uint32_t)N);
+}
+
+// UI command queue: producer threads against a verifying drain, then posts
+// from a "network" thread into the real dashboard drained each loop iteration
+static struct {
+    float    last_temp[TEMP_SENSOR_COUNT];
+    uint32_t applied;
+    uint32_t out_of_order;
+} uiq_sink;
+
+static void uiq_verify(const UiCmd& cmd) {
+    uiq_sink.applied++;
+    if (cmd.type != UI_CMD_TEMPERATURE) return;
+    if (cmd.value <= uiq_sink.last_temp[cmd.arg]) uiq_sink.out_of_order++;
+    uiq_sink.last_temp[cmd.arg] = cmd.value;
+}
+
+static void scenario_uiqueue() {
+    const int PER_PRODUCER = 100000;
+    ui_queue_init(nullptr);
+    ui_queue_reset_stats();
+    memset(&uiq_sink, 0, sizeof(uiq_sink));
+
+    // Three producers own a sensor each, a fourth toggles the WiFi icon
+    std::atomic<int> running(4);
+    std::atomic<uint32_t> retries(0);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; p++) {
+        producers.emplace_back([&, p]() {
+            for (int i = 1; i <= PER_PRODUCER; i++) {
+                bool ok = p < 3 ? ui_post_temperature((TempSensor)p, (float)i) : ui_post_wifi(i & 1);
+                if (!ok) {
+                    retries++;
+                    i--;
+                }
+                std::this_thread::yield();
+            }
+            running--;
+        });
+    }
+    uint32_t t0 = micros();
+    while (running.load() > 0) {
+        if (!ui_queue_drain(uiq_verify)) std::this_thread::yield();
+    }
+    for (auto& t : producers) t.join();
+    while (ui_queue_drain(uiq_verify)) {}
+    double us = micros() - t0;
+
+    UiQueueStats st;
+    ui_queue_get_stats(st);
+    bench_report("posted", st.posted, "");
+    bench_report("applied", st.applied, "");
+    bench_report("coalesced", st.coalesced, "");
+    bench_report("full (retried)", st.dropped, "");
+    bench_report("throughput", st.posted / us, "Mcmd/s");
+    bench_check("every post applied, coalesced or refused",
+                st.posted == st.applied + st.coalesced + st.dropped && st.dropped == retries.load() &&
+                st.applied == uiq_sink.applied);
+    bool last = true;
+    for (int s = 0; s < TEMP_SENSOR_COUNT; s++) last &= uiq_sink.last_temp[s] == (float)PER_PRODUCER;
+    bench_check("per-producer order kept", uiq_sink.out_of_order == 0);
+    bench_check("newest value per sensor applied", last);
+
+    // Real dashboard: a thread posts readings every 2 ms and a snapshot every
+    // 20 ms while the loop drains and renders
+    static TripleBuffer<HAWeatherData> snaps;
+    bench_fresh_screen();
+    ui_create();
+    ui_show_loading(false);
+    ui_queue_init(&snaps);
+    ui_queue_reset_stats();
+    std::atomic<bool> stop(false);
+    std::thread net([&]() {
+        for (int i = 0; !stop.load(); i++) {
+            ui_post_temperature(TEMP_INDOOR, 20.0f + (i % 50) * 0.1f);
+            if (i % 10 == 0) {
+                snaps.back() = make_mock_data(i / 10 + 1);
+                snaps.publish();
+                ui_post_snapshot();
+            }
+            delay(2);
+        }
+    });
+    uint32_t start = millis();
+    uint32_t frames = 0;
+    while (millis() - start < 500) {
+        ui_queue_drain();
+        lv_timer_handler();
+        frames++;
+        delay(5);
+    }
+    stop = true;
+    net.join();
+    ui_queue_drain();
+    ui_queue_get_stats(st);
+    bench_report("dashboard: applied", st.applied, "");
+    bench_report("dashboard: coalesced", st.coalesced, "");
+    bench_report("dashboard: max batch", st.max_depth, "");
+    bench_report("post->applied avg", st.applied ? st.latency_total_us / 1000.0 / st.applied : 0, "ms");
+    bench_report("post->applied p99 <=", ui_queue_percentile_us(st, 0.99f) / 1000.0, "ms");
+    bench_report("post->applied max", st.latency_max_us / 1000.0, "ms");
+    bench_check("dashboard: nothing dropped", st.dropped == 0 && st.posted == st.applied + st.coalesced);
+    ui_queue_init(nullptr);
+    temp_history_clear(TEMP_INDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+    temp_history_clear(TEMP_SAUNA);
+}
+
+// Task split: HA-sized parse work inline in an LVGL timer (the old single
+// loop) vs on a net thread posting snapshots, timing every UI iteration;
+// then a history backfill staged on the net thread and merged by the UI
+static const uint32_t TOPO_NOW = 1700000000;
+static std::string topo_json;
+static std::atomic<bool> topo_stop(false);
+static std::atomic<uint32_t> topo_net_busy_us(0);
+static TripleBuffer<HAWeatherData> topo_snapshots;
+
+// Parse the fixture without storing it: the CPU side of a fetch
+static void topo_fetch_work() {
+    HistoryBackfill b;
+    history_backfill_begin(b, TOPO_NOW);
+    for (size_t off = 0; off < topo_json.size(); off += 512) {
+        history_backfill_feed(b, topo_json.data() + off, std::min<size_t>(512, topo_json.size() - off));
+    }
+}
+
+static void topo_inline_cb(lv_timer_t* timer) {
+    (void)timer;
+    topo_fetch_work();
+}
+
+static void topo_net_task(void* arg) {
+    (void)arg;
+    for (int step = 1; !topo_stop.load(); step++) {
+        uint32_t t0 = micros();
+        topo_fetch_work();
+        topo_snapshots.back() = make_mock_data(step);
+        topo_snapshots.publish();
+        ui_post_snapshot();
+        topo_net_busy_us += micros() - t0;
+        delay(50);
+    }
+    topo_stop = false;   // handshake: the thread is done
+}
+
+static void topo_history_task(void* arg) {
+    HistoryBackfill b;
+    history_backfill_begin(b, TOPO_NOW, true);
+    history_backfill_add(b, HA_ENTITY_INDOOR_TEMP, TEMP_INDOOR);
+    history_backfill_add(b, HA_ENTITY_OUTDOOR_TEMP, TEMP_OUTDOOR);
+    history_backfill_feed(b, topo_json.data(), topo_json.size());
+    history_backfill_end(b);
+    ui_post_history();
+    ((std::atomic<bool>*)arg)->store(true);
+}
+
+// UI iterations for `ms`: drain + lv_timer_handler, like event_loop_run_once()
+static void topo_run_ui(uint32_t ms, uint32_t* max_us, uint32_t* busy_us) {
+    *max_us = *busy_us = 0;
+    uint32_t start = millis();
+    while (millis() - start < ms) {
+        uint32_t t0 = micros();
+        ui_queue_drain();
+        lv_timer_handler();
+        uint32_t us = micros() - t0;
+        *busy_us += us;
+        if (us > *max_us) *max_us = us;
+        delay(5);
+    }
+}
+
+static void scenario_topology() {
+    const uint32_t RUN_MS = 1000;
+    topo_json = make_mock_history(TOPO_NOW, 10000);
+    bench_fresh_screen();
+    ui_create();
+    ui_show_loading(false);
+    ui_queue_init(&topo_snapshots);
+    ui_queue_reset_stats();
+    uint32_t max_us, busy_us;
+
+    lv_timer_t* t = lv_timer_create(topo_inline_cb, 50, nullptr);
+    topo_run_ui(RUN_MS, &max_us, &busy_us);
+    lv_timer_del(t);
+    bench_report("one loop: longest UI iteration", max_us / 1000.0, "ms");
+    bench_report("one loop: UI thread busy", busy_us * 100.0 / (RUN_MS * 1000), "%");
+
+    topo_net_busy_us = 0;
+    task_spawn("net", topo_net_task, nullptr, NET_TASK_CORE, NET_TASK_PRIORITY, NET_TASK_STACK);
+    topo_run_ui(RUN_MS, &max_us, &busy_us);
+    topo_stop = true;
+    while (topo_stop.load()) delay(1);
+    UiQueueStats st;
+    ui_queue_get_stats(st);
+    bench_report("split: longest UI iteration", max_us / 1000.0, "ms");
+    bench_report("split: UI thread busy", busy_us * 100.0 / (RUN_MS * 1000), "%");
+    bench_report("split: net thread busy", topo_net_busy_us * 100.0 / (RUN_MS * 1000), "%");
+    bench_report("split: snapshots applied", st.applied, "");
+    bench_check("split: snapshots reach the UI", st.applied > 0 && st.dropped == 0);
+
+    // One-shot backfill on the net side, merged by the UI
+    temp_history_clear(TEMP_INDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+    std::atomic<bool> staged(false);
+    task_spawn("net", topo_history_task, &staged, NET_TASK_CORE, NET_TASK_PRIORITY, NET_TASK_STACK);
+    while (!staged.load()) delay(1);
+    bool untouched = temp_history_get(TEMP_INDOOR)->samples == 0;
+    ui_queue_drain();
+    bench_check("staged history invisible until merged", untouched);
+    bench_check("merged on the UI task", temp_history_get(TEMP_INDOOR)->samples == TEMP_HISTORY_SLOTS - 1 &&
+                temp_history_get(TEMP_OUTDOOR)->samples == TEMP_HISTORY_SLOTS - 1);
+    ui_queue_init(nullptr);
+    temp_history_clear(TEMP_INDOOR);
+    temp_history_clear(TEMP_OUTDOOR);
+}
+
+// Full-screen redraws of the dashboard, serial vs two bands per large blend.
+// The speedup needs a second CPU; identical flushed pixels are checked
+// either way.
+static void par_frames(bool parallel, int frames, uint32_t* hash, double* ms) {
+    draw_parallel_set_enabled(parallel);
+    draw_parallel_reset_stats();
+    flush_hash = 2166136261u;
+    flush_hash_on = true;
+    lv_obj_invalidate(lv_scr_act());
+    bench_refresh_us();
+    flush_hash_on = false;
+    *hash = flush_hash;
+
+    uint64_t total = 0;
+    for (int i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        total += bench_refresh_us();
+    }
+    *ms = total / 1000.0 / frames;
+}
+
+static void scenario_parallel() {
+    const int FRAMES = 20;
+    printf("  %u CPU(s), bands from %d px\n", std::thread::hardware_concurrency(), DRAW_PARALLEL_MIN_PX);
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(true);
+    lv_obj_t* overlay = lv_obj_get_child(lv_scr_act(), -1);
+
+    static const struct {
+        const char* label;
+        bool        loading;
+        lv_opa_t    opa;
+    } CASES[] = {
+        {"dashboard",          false, LV_OPA_COVER},
+        {"loading overlay 80", true,  LV_OPA_80},
+    };
+    for (const auto& c : CASES) {
+        ui_show_loading(c.loading);
+        lv_obj_set_style_bg_opa(overlay, c.opa, 0);
+
+        uint32_t serial_hash, par_hash;
+        double serial_ms, par_ms;
+        par_frames(false, FRAMES, &serial_hash, &serial_ms);
+        par_frames(true, FRAMES, &par_hash, &par_ms);
+        DrawParallelStats st;
+        draw_parallel_get_stats(st);
+
+        char metric[64];
+        snprintf(metric, sizeof(metric), "%s: one core", c.label);
+        bench_report(metric, serial_ms, "ms/frame");
+        snprintf(metric, sizeof(metric), "%s: two bands", c.label);
+        bench_report(metric, par_ms, "ms/frame");
+        snprintf(metric, sizeof(metric), "%s: speedup", c.label);
+        bench_report(metric, par_ms > 0 ? serial_ms / par_ms : 0, "x");
+        snprintf(metric, sizeof(metric), "%s: px in split blends", c.label);
+        uint64_t total_px = st.split_px + st.inline_px;
+        bench_report(metric, total_px ? 100.0 * st.split_px / total_px : 0, "%");
+        snprintf(metric, sizeof(metric), "%s: UI waited for worker", c.label);
+        bench_report(metric, st.wait_us / 1000.0 / (FRAMES + 1), "ms/frame");
+        snprintf(metric, sizeof(metric), "%s: identical flushed pixels", c.label);
+        bench_check(metric, serial_hash == par_hash && st.split > 0);
+    }
+    draw_parallel_set_enabled(false);
+}
+
+// Blend kernels: the scalar reference against lv_color_mix(), every variant
+// against the reference on random rectangles (odd widths and offsets, masks
+// with 0/255 runs), throughput per kernel, then full dashboard redraws whose
+// flushed pixels must match LVGL's own blend
+static uint32_t kern_rand() {
+    static uint32_t x = 2463534242u;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+static void kern_fill_mask(std::vector<uint8_t>& mask, bool glyph) {
+    for (size_t i = 0; i < mask.size(); i++) {
+        uint32_t r = kern_rand();
+        if (!glyph) mask[i] = (uint8_t)r;
+        else mask[i] = (r & 3) == 0 ? (uint8_t)(r >> 8) : (r & 4) ? LV_OPA_COVER : 0;
+    }
+}
+
+// Hash of one flushed full-screen frame, then the average of 20 redraws
+static uint32_t kern_frames(const BlendKernels* k, double* ms) {
+    blend_kernels_use(k);
+    flush_hash = 2166136261u;
+    flush_hash_on = true;
+    lv_obj_invalidate(lv_scr_act());
+    bench_refresh_us();
+    flush_hash_on = false;
+
+    uint64_t total = 0;
+    for (int i = 0; i < 20; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        total += bench_refresh_us();
+    }
+    *ms = total / 1000.0 / 20;
+    return flush_hash;
+}
+
+static void scenario_kernels() {
+    const int W = SCREEN_WIDTH, H = SCREEN_HEIGHT / 10;
+    uint32_t mismatches = 0;
+    for (int i = 0; i < 1000000; i++) {
+        lv_color_t fg, bg;
+        fg.full = (uint16_t)kern_rand();
+        bg.full = (uint16_t)kern_rand();
+        uint8_t mix = (uint8_t)kern_rand();
+        if (blend_mix565(fg.full, bg.full, mix) != lv_color_mix(fg, bg, mix).full) mismatches++;
+    }
+    bench_check("reference == lv_color_mix() over 1M random pixels", mismatches == 0);
+
+    std::vector<uint16_t> ref(W * H), out(W * H), src(W * H), init(W * H);
+    std::vector<uint8_t> mask(W * H);
+    for (auto& px : src) px = (uint16_t)kern_rand();
+    for (auto& px : init) px = (uint16_t)kern_rand();
+    static const uint8_t OPAS[] = {0, 1, 3, 4, 11, 12, 127, 128, LV_OPA_80, 252, 253, 254, 255};
+    const BlendKernels* scalar = blend_kernels_get(0);
+
+    for (int v = 1; v < blend_kernels_count(); v++) {
+        const BlendKernels* k = blend_kernels_get(v);
+        if (!blend_kernels_supported(v)) {
+            printf("  %s: not supported on this CPU\n", k->name);
+            continue;
+        }
+        int bad = 0;
+        for (int it = 0; it < 3000 && !bad; it++) {
+            int x0 = kern_rand() % W, y0 = kern_rand() % H;
+            int w = 1 + kern_rand() % (W - x0), h = 1 + kern_rand() % (H - y0);
+            uint8_t opa = it & 1 ? OPAS[kern_rand() % sizeof(OPAS)] : (uint8_t)kern_rand();
+            int mode = kern_rand() % 3;   // no mask, random mask, glyph-like mask
+            if (mode) kern_fill_mask(mask, mode == 2);
+            const uint8_t* m = mode ? mask.data() + (kern_rand() % 7) : nullptr;
+            uint16_t color = (uint16_t)kern_rand();
+            size_t off = y0 * W + x0;
+
+            for (int op = 0; op < 3; op++) {
+                ref = init;
+                out = init;
+                if (op == 0) {
+                    scalar->fill(&ref[off], W, w, h, color);
+                    k->fill(&out[off], W, w, h, color);
+                } else if (op == 1) {
+                    scalar->fill_blend(&ref[off], W, w, h, color, opa, m, W - 7);
+                    k->fill_blend(&out[off], W, w, h, color, opa, m, W - 7);
+                } else {
+                    const uint16_t* s = src.data() + (kern_rand() % 5);
+                    scalar->map_blend(&ref[off], W, s, W - 5, w, h, opa, m, W - 7);
+                    k->map_blend(&out[off], W, s, W - 5, w, h, opa, m, W - 7);
+                }
+                if (ref != out) bad++;
+            }
+        }
+        char metric[64];
+        snprintf(metric, sizeof(metric), "%s == scalar reference (9000 random blends)", k->name);
+        bench_check(metric, bad == 0);
+    }
+
+    // Throughput on a full draw buffer over flat 64 px runs, like card backgrounds
+    kern_fill_mask(mask, true);
+    for (size_t i = 0; i < init.size(); i++) init[i] = (uint16_t)(0x2104 * (1 + (i / 64) % 4));
+    const int REPS = 50;
+    for (int v = 0; v < blend_kernels_count(); v++) {
+        if (!blend_kernels_supported(v)) continue;
+        const BlendKernels* k = blend_kernels_get(v);
+        static const char* OPS[] = {"fill", "fill opa 80%", "fill glyph mask", "image opa 80%"};
+        for (int op = 0; op < 4; op++) {
+            out = init;
+            uint32_t t0 = micros();
+            for (int r = 0; r < REPS; r++) {
+                if (op == 0) k->fill(out.data(), W, W, H, 0x1234);
+                else if (op == 1) k->fill_blend(out.data(), W, W, H, 0x1234, LV_OPA_80, nullptr, 0);
+                else if (op == 2) k->fill_blend(out.data(), W, W, H, 0x1234, LV_OPA_COVER, mask.data(), W);
+                else k->map_blend(out.data(), W, src.data(), W, W, H, LV_OPA_80, nullptr, 0);
+            }
+            uint32_t us = micros() - t0;
+            char metric[64];
+            snprintf(metric, sizeof(metric), "%s: %s", k->name, OPS[op]);
+            bench_report(metric, us ? (double)W * H * REPS / us : 0, "Mpx/s");
+        }
+    }
+
+    // Whole frames through the draw context: LVGL's blend vs every kernel
+    // set, with the flushed pixels required to match
+    const BlendKernels* was = blend_kernels_active();
+    bench_fresh_screen();
+    ui_create();
+    ui_update(make_mock_data(1));
+    ui_show_loading(true);
+    lv_obj_t* overlay = lv_obj_get_child(lv_scr_act(), -1);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_80, 0);
+    for (int overlay_on = 0; overlay_on < 2; overlay_on++) {
+        ui_show_loading(overlay_on);
+        const char* label = overlay_on ? "dashboard + 80% overlay" : "dashboard";
+        double lvgl_ms;
+        uint32_t lvgl_hash = kern_frames(nullptr, &lvgl_ms);
+        char metric[64];
+        snprintf(metric, sizeof(metric), "%s, LVGL blend", label);
+        bench_report(metric, lvgl_ms, "ms/frame");
+        for (int v = 0; v < blend_kernels_count(); v++) {
+            if (!blend_kernels_supported(v)) continue;
+            const BlendKernels* k = blend_kernels_get(v);
+            double ms;
+            uint32_t hash = kern_frames(k, &ms);
+            snprintf(metric, sizeof(metric), "%s, %s blend", label, k->name);
+            bench_report(metric, ms, "ms/frame");
+            snprintf(metric, sizeof(metric), "%s, %s: same pixels as LVGL", label, k->name);
+            bench_check(metric, hash == lvgl_hash);
+        }
+    }
+    blend_kernels_use(was);
+}
+
+static const BenchScenario SCENARIOS[] = {
+    {"ui_update", "dashboard objects/heap and ui_update() + refresh cost", scenario_ui_update},
+    {"loading",   "spinner frame cost with translucent vs opaque loading overlay", scenario_loading},
+    {"icons",     "weather icon redraw: glyph label vs pre-rendered image", scenario_icons},
+    {"fonts",     "glyph render time per font variant (compressed vs uncompressed subsets)", scenario_fonts},
+    {"forecast",  "forecast strip heap/objects for 3/7/24 entries, scroll step cost", scenario_forecast},
+    {"idle",      "idle main loop wakeups/s, idle% and CPU: 5 ms poll vs event loop", scenario_idle},
+    {"touch",     "touch I2C reads/min idle (poll vs INT), scripted tap and flick", scenario_touch},
+    {"alloc",     "tiered LVGL allocator: integrity, alloc cost vs malloc, dashboard pool usage", scenario_alloc},
+    {"hud",       "performance HUD update cost and redrawn area", scenario_hud},
+    {"profile",   "callback profiler overhead and dashboard profile", scenario_profile},
+    {"latency",   "touch-to-photon latency of scripted toggle taps (fails above budget)", scenario_latency},
+    {"units",     "C/F toggle cost and redrawn px: string swap vs full ui_update()", scenario_units},
+    {"fmt",       "num_fmt vs snprintf: bit-for-bit over the float range, cost per call", scenario_fmt},
+    {"history",   "temperature history ring: bookkeeping, put cost, sparkline-only redraw", scenario_history},
+    {"backfill",  "streaming HA history parse + downsample of a 10k-point 24 h fixture", scenario_backfill},
+    {"tsdb",      "flash sample log: append/scan cost, remount, torn writes, wraparound wear", scenario_tsdb},
+    {"snapshot",  "triple buffer stress: producer thread vs UI reader, torn/reordered checks", scenario_snapshot},
+    {"uiqueue",   "UI command queue: 4 producer threads, coalescing, post->applied latency", scenario_uiqueue},
+    {"topology",  "UI/net task split: UI iteration stalls inline vs net thread, staged history merge", scenario_topology},
+    {"parallel",  "full-screen redraw on one core vs two-band blends, identical pixels", scenario_parallel},
+    {"kernels",   "RGB565 blend kernels: exactness vs scalar and LVGL's blend, Mpx/s, frame time", scenario_kernels},
+};
+static const int SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+int bench_main(int argc, char** argv) {
+    if (argc > 0 && strcmp(argv[0], "list") == 0) {
+        for (int i = 0; i < SCENARIO_COUNT; i++) {
+            printf("%-16s %s\n", SCENARIOS[i].name, SCENARIOS[i].desc);
+        }
+        return 0;
+    }
+
+    lv_init();
+    bench_display_init();
+
+    int ran = 0;
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        bool selected = argc == 0;
+        for (int a = 0; a < argc; a++) {
+            if (strcmp(argv[a], SCENARIOS[i].name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        printf("== %s: %s\n", SCENARIOS[i].name, SCENARIOS[i].desc);
+        SCENARIOS[i].run();
+        ran++;
+    }
+
+    if (ran == 0) {
+        printf("No matching scenario (try --bench list)\n");
+        return 1;
+    }
+    if (check_failures) printf("%d check(s) failed\n", check_failures);
+    return check_failures ? 1 : 0;
+}
+
+#endif // SIMULATOR
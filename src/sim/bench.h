@@ -0,0 +1,19 @@
+#pragma once
+#include <lvgl.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Headless benchmark harness (simulator build only, no SDL window):
+//   program --bench [scenario ...]    run the named scenarios (default: all)
+//   program --bench list              list scenarios
+int bench_main(int argc, char** argv);
+
+// ----- Helpers shared by scenarios -----
+uint32_t bench_now_us();
+uint32_t bench_refresh_us();            // render everything invalidated, return elapsed us
+void     bench_settle(uint32_t ms);     // run lv_timer_handler for a while (animations)
+void     bench_fresh_screen();          // load an empty screen, delete the previous one
+size_t   bench_heap_used();             // process heap in use (bytes)
+uint32_t bench_obj_count();             // objects on the active screen + top layer
+void     bench_report(const char* metric, double value, const char* unit);
+void     bench_check(const char* what, bool ok);   // prints ok/FAIL; any FAIL makes --bench exit 1
@@ -5,6 +5,12 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <chrono>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
 
 // Minimal Arduino String class shim
 class String {
@@ -19,3 +25,46 @@ public:
     bool operator==(const String& o) const { return _s == o._s; }
     String& operator=(const char* s) { _s = s ? s : ""; return *this; }
 };
+
+#define IRAM_ATTR
+
+// Timing shims (monotonic, relative to first use)
+inline unsigned long micros() {
+    static const auto t0 = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+inline unsigned long millis() {
+    return micros() / 1000;
+}
+
+inline void delay(unsigned long ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// Serial shim: everything goes to stdout
+class HardwareSerial {
+public:
+    void begin(unsigned long) {}
+    int printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vprintf(fmt, ap);
+        va_end(ap);
+        return n;
+    }
+    void print(const char* s) { fputs(s, stdout); }
+    void println(const char* s = "") { puts(s); }
+    // Input comes from stdin, non-blocking
+    int available() {
+        pollfd p = {0, POLLIN, 0};
+        return ::poll(&p, 1, 0) > 0 && (p.revents & POLLIN) ? 1 : 0;
+    }
+    int read() {
+        unsigned char c;
+        return ::read(0, &c, 1) == 1 ? c : -1;
+    }
+};
+
+inline HardwareSerial Serial;
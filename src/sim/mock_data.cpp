@@ -0,0 +1,101 @@
+#ifdef SIMULATOR
+
+#include "mock_data.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char* CONDITIONS[] = {
+    "partlycloudy", "cloudy", "rainy", "sunny", "snowy", "fog", "lightning-rainy", "clear-night",
+};
+static const int CONDITION_COUNT = sizeof(CONDITIONS) / sizeof(CONDITIONS[0]);
+
+HAWeatherData make_mock_data(int step) {
+    HAWeatherData d{};
+    d.has_data = true;
+    d.last_updated = step == 0 ? "14:32" : (step % 2 ? "14:33" : "14:34");
+
+    float drift = (step % 7) * 0.3f;
+    d.indoor_temp  = {22.4f + drift, true};
+    d.outdoor_temp = {-2.1f - drift * 2.0f, true};
+    d.sauna_temp   = {68.5f + drift * 5.0f, true};
+
+    d.current.condition   = CONDITIONS[step % CONDITION_COUNT];
+    d.current.temperature = 5.0f + drift;
+    d.current.humidity    = 72.0f + (step % 5);
+    d.current.wind_speed  = 14.0f + (step % 3);
+    d.current.valid       = true;
+
+    static const char* DAYS[] = {"Wed", "Thu", "Fri", "Sat", "Sun", "Mon", "Tue"};
+    d.forecast_count = 7;
+    for (int i = 0; i < d.forecast_count; i++) {
+        d.forecast[i] = {DAYS[i], CONDITIONS[(step + i + 1) % CONDITION_COUNT],
+                         8.0f + i * 2.0f + drift, 2.0f + i - drift, true, true};
+    }
+
+    return d;
+}
+
+float mock_history_value(int entity, uint32_t t) {
+    float day = (t % 86400) * 6.2831853f / 86400.0f;
+    return entity == 0 ? 21.5f + 1.5f * sinf(day) : 4.0f + 7.0f * sinf(day - 1.0f);
+}
+
+static void iso_time(char* buf, size_t len, uint32_t t, uint32_t us) {
+    time_t tt = t;
+    struct tm tm_val;
+    gmtime_r(&tt, &tm_val);
+    size_t n = strftime(buf, len, "%Y-%m-%dT%H:%M:%S", &tm_val);
+    snprintf(buf + n, len - n, ".%06u+00:00", (unsigned)us);
+}
+
+std::string make_mock_history(uint32_t end_s, int points, int* unavailable) {
+    static const char* const ENTITIES[2] = {HA_ENTITY_INDOOR_TEMP, HA_ENTITY_OUTDOOR_TEMP};
+    const uint32_t start = end_s - 86400;
+    uint32_t rng = 12345;
+    int skipped = 0;
+
+    std::string out;
+    out.reserve(points * 64);
+    out += "[";
+    char ts[40], item[320];
+    for (int e = 0; e < 2; e++) {
+        int n = points / 2;
+        out += e ? ",[" : "[";
+        for (int i = 0; i < n; i++) {
+            // Spread over the window with jitter; the first is the state at the start
+            uint32_t t = start + (uint32_t)((uint64_t)i * 86400 / n);
+            rng = rng * 1103515245 + 12345;
+            if (i) t += (rng >> 16) % (86400 / n);
+            else t -= 3600;
+            iso_time(ts, sizeof(ts), t, (rng >> 8) % 1000000);
+
+            char state[16];
+            if (i % 50 == 49) {
+                strcpy(state, "unavailable");
+                skipped++;
+            } else {
+                float noise = ((int)((rng >> 4) % 11) - 5) * 0.01f;
+                snprintf(state, sizeof(state), "%.2f", mock_history_value(e, t) + noise);
+            }
+
+            if (i == 0) {
+                snprintf(item, sizeof(item),
+                         "{\"entity_id\":\"%s\",\"state\":\"%s\",\"attributes\":{\"state_class\":\"measurement\","
+                         "\"unit_of_measurement\":\"\\u00b0C\",\"device_class\":\"temperature\","
+                         "\"friendly_name\":\"Sensor \\\"%d\\\" {[,:]}\"},\"last_changed\":\"%s\",\"last_updated\":\"%s\"}",
+                         ENTITIES[e], state, e, ts, ts);
+            } else {
+                snprintf(item, sizeof(item), ",{\"state\":\"%s\",\"last_changed\":\"%s\"}", state, ts);
+            }
+            out += item;
+        }
+        out += "]";
+    }
+    out += "]";
+    if (unavailable) *unavailable = skipped;
+    return out;
+}
+
+#endif // SIMULATOR
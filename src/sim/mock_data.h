@@ -0,0 +1,14 @@
+#pragma once
+#include "../ha_client.h"
+#include <string>
+
+// Deterministic mock snapshot; step 0 is the classic simulator screen,
+// later steps drift the values so every update changes the dashboard.
+HAWeatherData make_mock_data(int step = 0);
+
+// HA /api/history/period response (minimal_response) for the indoor and
+// outdoor sensors over the 24 h before end_s: `points` state changes at
+// irregular times, every 50th "unavailable". Values follow
+// mock_history_value() within +-0.05.
+std::string make_mock_history(uint32_t end_s, int points, int* unavailable = nullptr);
+float mock_history_value(int entity, uint32_t t);
@@ -0,0 +1,32 @@
+#ifdef SIMULATOR
+
+#include "mock_touch.h"
+#include "../touch_reader.h"
+
+static bool     touch_down = false;
+static int16_t  touch_x = 0;
+static int16_t  touch_y = 0;
+static uint32_t read_count = 0;
+
+void mock_touch_set(bool down, int16_t x, int16_t y) {
+    if (down == touch_down && (!down || (x == touch_x && y == touch_y))) return;
+    touch_down = down;
+    if (down) {
+        touch_x = x;
+        touch_y = y;
+    }
+    touch_reader_irq();
+}
+
+bool mock_touch_read(int16_t* x, int16_t* y) {
+    read_count++;
+    *x = touch_x;
+    *y = touch_y;
+    return touch_down;
+}
+
+uint32_t mock_touch_reads() {
+    return read_count;
+}
+
+#endif // SIMULATOR
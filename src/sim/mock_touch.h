@@ -0,0 +1,10 @@
+#pragma once
+#include <stdint.h>
+
+// Stand-in for the GT911 in the simulator and benchmarks: holds one touch
+// point, raises touch_reader_irq() like the INT line whenever the point
+// changes, and counts reads as I2C transactions would be counted.
+
+void mock_touch_set(bool down, int16_t x, int16_t y);
+bool mock_touch_read(int16_t* x, int16_t* y);   // touch_read_fn
+uint32_t mock_touch_reads();
@@ -3,37 +3,58 @@
 #include <lvgl.h>
 #include <sdl/sdl.h>   // lv_drivers SDL
 
-#include <unistd.h>
 #include <cstdio>
+#include <cstring>
 
 #include "../ui.h"
+#include "../redraw_stats.h"
+#include "../event_loop.h"
+#include "../serial_console.h"
+#include "../mem_telemetry.h"
+#include "../perf_hud.h"
+#include "../profiler.h"
+#include "../input_latency.h"
+#include "../blend_kernels.h"
+#include "../draw_parallel.h"
+#include "../ts_store.h"
+#include "../triple_buffer.h"
+#include "../ui_queue.h"
+#include "../tasks.h"
+#include "../touch_reader.h"
+#include "mock_data.h"
+#include "mock_touch.h"
+#include "bench.h"
 
 // SDL driver exposes this flag
 extern volatile bool sdl_quit_qry;
 
-static HAWeatherData make_mock_data() {
-    HAWeatherData d{};
-    d.has_data = true;
-    d.last_updated = "14:32";
-
-    d.indoor_temp  = {22.4f, true};
-    d.outdoor_temp = {-2.1f, true};
-    d.sauna_temp   = {68.5f, true};
-
-    d.current.condition   = "partlycloudy";
-    d.current.temperature = 5.0f;
-    d.current.humidity    = 72.0f;
-    d.current.wind_speed  = 14.0f;
-    d.current.valid       = true;
-
-    d.forecast[0] = {"Wed", "cloudy",    8.0f, 2.0f, true};
-    d.forecast[1] = {"Thu", "rainy",    12.0f, 5.0f, true};
-    d.forecast[2] = {"Fri", "sunny",    18.0f, 9.0f, true};
+static TripleBuffer<HAWeatherData> snapshots;
+
+// Net task stand-in on its own thread: a drifting mock snapshot every poll
+static void sim_net_task(void* arg) {
+    (void)arg;
+    for (int step = 0;; step++) {
+        uint32_t t0 = micros();
+        ts_store_poll();
+        snapshots.back() = make_mock_data(step);
+        snapshots.publish();
+        ui_post_snapshot();
+        perf_hud_set_network(-58, HAFetchTimings{{112, 98, 131, 240, 415}, 996});   // plausible HUD values
+        cpu_stats_add_busy(NET_TASK_CORE, micros() - t0);
+        delay(HA_POLL_INTERVAL_MS);
+    }
+}
 
-    return d;
+static void sim_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    redraw_stats_on_flush(area, color_p);
+    sdl_display_flush(drv, area, color_p);
 }
 
-int main(int /*argc*/, char** /*argv*/) {
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        return bench_main(argc - 2, argv + 2);
+    }
+
     lv_init();
 
     // Initialize SDL display via lv_drivers
@@ -48,8 +69,12 @@ int main(int /*argc*/, char** /*argv*/) {
     lv_disp_drv_init(&disp_drv);
     disp_drv.hor_res  = 800;
     disp_drv.ver_res  = 480;
-    disp_drv.flush_cb = sdl_display_flush;
+    disp_drv.flush_cb = sim_flush_cb;
     disp_drv.draw_buf = &draw_buf;
+    redraw_stats_attach(&disp_drv);
+    input_latency_attach_disp(&disp_drv);
+    blend_kernels_attach(&disp_drv);
+    draw_parallel_attach(&disp_drv);
     lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
 
     // Dark theme
@@ -62,29 +87,54 @@ int main(int /*argc*/, char** /*argv*/) {
     );
     lv_disp_set_theme(disp, theme);
 
-    // --- Mouse input (SDL provides this) ---
+    // --- Mouse input: SDL mouse -> mock GT911 -> interrupt-driven reader ---
     static lv_indev_drv_t indev_drv;
     lv_indev_drv_init(&indev_drv);
-    indev_drv.type    = LV_INDEV_TYPE_POINTER;
-    indev_drv.read_cb = sdl_mouse_read;
+    indev_drv.type = LV_INDEV_TYPE_POINTER;
+    touch_reader_init(&indev_drv, mock_touch_read, true);
+    input_latency_attach_indev(&indev_drv);
     lv_indev_drv_register(&indev_drv);
 
     // --- Build UI ---
     ui_create();
     ui_set_wifi_status(true);
     ui_show_loading(false);
+    ui_queue_init(&snapshots);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--heatmap") == 0) redraw_stats_set_overlay(true);
+    }
 
-    HAWeatherData data = make_mock_data();
-    ui_update(data);
+    serial_console_init();
+    mem_telemetry_init();
+    perf_hud_init();
+    profiler_init();
+    input_latency_init();
+    draw_parallel_init();
+    cpu_stats_init();
+    ts_store_init();   // tsdb.bin in the working directory
+    task_spawn("net", sim_net_task, nullptr, NET_TASK_CORE, NET_TASK_PRIORITY, NET_TASK_STACK);
 
-    printf("Simulator running — close window to exit\n");
+    printf("Simulator running — close window to exit, type help for commands\n");
 
-    // --- Main loop ---
+    // --- Main loop (SDL input is polled by an lv_drivers timer) ---
+    event_loop_init();
     while (!sdl_quit_qry) {
-        lv_timer_handler();
-        usleep(5000);
+        event_loop_run_once();
+        // Mouse state is updated by lv_drivers' SDL event timer
+        lv_indev_data_t mouse = {};
+        sdl_mouse_read(&indev_drv, &mouse);
+        mock_touch_set(mouse.state == LV_INDEV_STATE_PRESSED, mouse.point.x, mouse.point.y);
     }
 
+    EventLoopStats ls;
+    event_loop_get_stats(ls);
+    printf("Main loop: %.1f wakeups/s, %.1f%% idle\n", ls.wakeups_per_s, ls.idle_pct);
+    TouchReaderStats ts;
+    touch_reader_get_stats(ts);
+    printf("Touch: %u reads, %u irqs\n", (unsigned)ts.reads, (unsigned)ts.irqs);
+    redraw_stats_dump();
+    if (profiler_enabled()) profiler_dump();
     return 0;
 }
 
@@ -0,0 +1,123 @@
+#include "tasks.h"
+#include "serial_console.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <atomic>
+
+#ifdef SIMULATOR
+#include <thread>
+#else
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// Idle task run time per core: needs both options in the FreeRTOS config
+#if !defined(SIMULATOR) && CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS && CONFIG_FREERTOS_USE_TRACE_FACILITY
+#define CPU_STATS_IDLE_TASKS 1
+#else
+#define CPU_STATS_IDLE_TASKS 0
+#endif
+
+static const char* TAG = "TASK";
+
+void* task_spawn(const char* name, task_fn fn, void* arg, int core, int priority, uint32_t stack) {
+#ifdef SIMULATOR
+    std::thread(fn, arg).detach();
+    Serial.printf("[%s] %s started (thread for core %d)\n", TAG, name, core);
+    (void)priority;
+    (void)stack;
+    return nullptr;
+#else
+    TaskHandle_t handle = nullptr;
+    if (xTaskCreatePinnedToCore(fn, name, stack, arg, priority, &handle, core) != pdPASS) {
+        Serial.printf("[%s] cannot start %s\n", TAG, name);
+        return nullptr;
+    }
+    Serial.printf("[%s] %s on core %d, priority %d, %lu B stack\n", TAG, name, core, priority,
+                  (unsigned long)stack);
+    return handle;
+#endif
+}
+
+// ----- Per-core load -----
+static std::atomic<uint32_t> busy_us[CPU_STATS_CORES];
+static std::atomic<uint32_t> wait_us[CPU_STATS_CORES];
+static CpuStats stats = {};
+static uint32_t window_start_us = 0;
+
+#if CPU_STATS_IDLE_TASKS
+static uint32_t idle_last[CPU_STATS_CORES];
+static uint32_t runtime_last = 0;
+
+static void read_idle(uint32_t* idle) {
+    for (int c = 0; c < CPU_STATS_CORES; c++) {
+        TaskStatus_t st;
+        vTaskGetInfo(xTaskGetIdleTaskHandleForCPU(c), &st, pdFALSE, eInvalid);
+        idle[c] = st.ulRunTimeCounter;
+    }
+}
+#endif
+
+static void sample_cb(lv_timer_t* timer) {
+    (void)timer;
+    uint32_t now = micros();
+    uint32_t elapsed = now - window_start_us;
+    window_start_us = now;
+    if (!elapsed) return;
+
+#if CPU_STATS_IDLE_TASKS
+    // Run-time counter units, whatever clock the FreeRTOS config picked
+    uint32_t idle[CPU_STATS_CORES];
+    read_idle(idle);
+    uint32_t runtime = portGET_RUN_TIME_COUNTER_VALUE();
+    uint32_t total = runtime - runtime_last;
+    runtime_last = runtime;
+#endif
+
+    for (int c = 0; c < CPU_STATS_CORES; c++) {
+        uint32_t busy = busy_us[c].exchange(0, std::memory_order_relaxed);
+        uint32_t wait = wait_us[c].exchange(0, std::memory_order_relaxed);
+        float pct = busy > wait ? 100.0f * (busy - wait) / elapsed : 0.0f;
+#if CPU_STATS_IDLE_TASKS
+        if (total) pct = 100.0f - 100.0f * (idle[c] - idle_last[c]) / total;
+        idle_last[c] = idle[c];
+#endif
+        stats.load_pct[c] = pct < 0 ? 0 : pct > 100 ? 100 : pct;
+    }
+    stats.from_idle_tasks = CPU_STATS_IDLE_TASKS;
+}
+
+void cpu_stats_add_busy(int core, uint32_t us) {
+    if (core >= 0 && core < CPU_STATS_CORES) busy_us[core].fetch_add(us, std::memory_order_relaxed);
+}
+
+void cpu_stats_add_wait(int core, uint32_t us) {
+    if (core >= 0 && core < CPU_STATS_CORES) wait_us[core].fetch_add(us, std::memory_order_relaxed);
+}
+
+void cpu_stats_get(CpuStats& out) {
+    out = stats;
+}
+
+static void cmd_cpu(const char* args) {
+    (void)args;
+    for (int c = 0; c < CPU_STATS_CORES; c++) {
+        const char* role = c == UI_TASK_CORE ? (c == NET_TASK_CORE ? "ui+net" : "ui") : c == NET_TASK_CORE ? "net" : "-";
+        Serial.printf("[%s] core %d (%s): %.1f%% %s\n", TAG, c, role, stats.load_pct[c],
+                      stats.from_idle_tasks ? "load" : "active");
+    }
+    Serial.printf("[%s] source: %s, %d s window\n", TAG,
+                  stats.from_idle_tasks ? "FreeRTOS idle tasks"
+                                        : "wall-clock time of our task loops, not CPU load (net includes network waits)",
+                  CPU_STATS_WINDOW_MS / 1000);
+}
+
+void cpu_stats_init() {
+    window_start_us = micros();
+#if CPU_STATS_IDLE_TASKS
+    read_idle(idle_last);
+    runtime_last = portGET_RUN_TIME_COUNTER_VALUE();
+#endif
+    lv_timer_create(sample_cb, CPU_STATS_WINDOW_MS, nullptr);
+    serial_console_add("cpu", "per-core load, or our tasks' active time (UI and net task topology)", cmd_cpu);
+}
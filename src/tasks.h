@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+#include "config.h"
+
+// Task topology: the UI task (LVGL, touch, flush) on UI_TASK_CORE, the net
+// task (WiFi, HTTP + JSON, flash log) on NET_TASK_CORE. They share nothing
+// but the snapshot triple buffer and the UI command queue (ui_queue.h).
+// In the simulator tasks are plain threads; core and priority are ignored.
+
+typedef void (*task_fn)(void* arg);
+
+// Returns the FreeRTOS TaskHandle_t (nullptr in the simulator or on failure)
+void* task_spawn(const char* name, task_fn fn, void* arg, int core, int priority, uint32_t stack);
+
+// Per-core load, refreshed every CPU_STATS_WINDOW_MS. With FreeRTOS run-time
+// stats it is 100% minus the idle task's share. Without them (the prebuilt
+// Arduino-ESP32 FreeRTOS has them off) it is only the share of wall-clock
+// time our tasks spent in their work loops: "active", not load. On the net
+// core that includes waiting on HTTP and TLS.
+struct CpuStats {
+    float load_pct[CPU_STATS_CORES];
+    bool  from_idle_tasks;   // FreeRTOS run-time stats (includes WiFi/lwIP), else our tasks' active time
+};
+
+void cpu_stats_init();                           // window timer, "cpu" command (UI task)
+void cpu_stats_add_busy(int core, uint32_t us);  // any task: time spent working on `core`
+void cpu_stats_add_wait(int core, uint32_t us);  // blocked inside a busy span: not counted
+void cpu_stats_get(CpuStats& out);
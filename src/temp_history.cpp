@@ -0,0 +1,126 @@
+#include "temp_history.h"
+
+static TempHistory histories[TEMP_SENSOR_COUNT];
+static TempHistory staged[TEMP_SENSOR_COUNT];   // filled by another task, merged on the UI task
+static bool        initialized = false;
+
+static void rescan(TempHistory* h) {
+    h->min = h->max = TEMP_HISTORY_GAP;
+    h->samples = 0;
+    for (int i = 0; i < TEMP_HISTORY_SLOTS; i++) {
+        int16_t v = h->value[i];
+        if (v == TEMP_HISTORY_GAP) continue;
+        if (h->samples++ == 0 || v < h->min) h->min = v;
+        if (h->samples == 1 || v > h->max) h->max = v;
+    }
+}
+
+static void clear(TempHistory* h) {
+    for (int i = 0; i < TEMP_HISTORY_SLOTS; i++) h->value[i] = TEMP_HISTORY_GAP;
+    h->newest_slot = 0;
+    h->head = 0;
+    h->samples = 0;
+    h->min = h->max = TEMP_HISTORY_GAP;
+}
+
+void temp_history_clear(TempSensor sensor) {
+    clear(&histories[sensor]);
+}
+
+static void init() {
+    initialized = true;
+    for (int s = 0; s < TEMP_SENSOR_COUNT; s++) clear(&histories[s]);
+}
+
+const TempHistory* temp_history_get(TempSensor sensor) {
+    if (!initialized) init();
+    return &histories[sensor];
+}
+
+static bool put(TempHistory* h, uint32_t epoch_s, float celsius) {
+    if (celsius != celsius) return false;   // NaN
+    float t10 = celsius * 10.0f;
+    if (t10 < -32767.0f) t10 = -32767.0f;
+    if (t10 > 32767.0f) t10 = 32767.0f;
+    int16_t v = (int16_t)(t10 + (t10 < 0 ? -0.5f : 0.5f));
+
+    uint32_t slot = epoch_s / TEMP_HISTORY_INTERVAL_S;
+    if (h->samples == 0) h->newest_slot = slot;
+
+    bool shifted = false;
+    bool dropped_extreme = false;
+    int idx;
+    if (slot > h->newest_slot) {
+        // Advance, leaving gaps for slots without a reading
+        uint32_t steps = slot - h->newest_slot;
+        if (steps > TEMP_HISTORY_SLOTS) steps = TEMP_HISTORY_SLOTS;
+        for (uint32_t i = 0; i < steps; i++) {
+            h->head = (h->head + 1) % TEMP_HISTORY_SLOTS;
+            int16_t old = h->value[h->head];
+            if (old != TEMP_HISTORY_GAP) {
+                h->samples--;
+                if (old == h->min || old == h->max) dropped_extreme = true;
+            }
+            h->value[h->head] = TEMP_HISTORY_GAP;
+        }
+        h->newest_slot = slot;
+        idx = h->head;
+        shifted = true;
+    } else {
+        uint32_t age = h->newest_slot - slot;
+        if (age >= TEMP_HISTORY_SLOTS) return false;
+        idx = (h->head + TEMP_HISTORY_SLOTS - age) % TEMP_HISTORY_SLOTS;
+    }
+
+    int16_t old = h->value[idx];
+    if (old == v && !shifted) return false;
+    h->value[idx] = v;
+    if (old != TEMP_HISTORY_GAP && (old == h->min || old == h->max)) dropped_extreme = true;
+
+    if (dropped_extreme) {
+        rescan(h);
+    } else {
+        if (old == TEMP_HISTORY_GAP) h->samples++;
+        if (h->min == TEMP_HISTORY_GAP || v < h->min) h->min = v;
+        if (h->max == TEMP_HISTORY_GAP || v > h->max) h->max = v;
+    }
+    return true;
+}
+
+bool temp_history_put(TempSensor sensor, uint32_t epoch_s, float celsius) {
+    if (!initialized) init();
+    return put(&histories[sensor], epoch_s, celsius);
+}
+
+// ----- Staging -----
+void temp_history_stage_clear() {
+    for (int s = 0; s < TEMP_SENSOR_COUNT; s++) clear(&staged[s]);
+}
+
+bool temp_history_stage(TempSensor sensor, uint32_t epoch_s, float celsius) {
+    return put(&staged[sensor], epoch_s, celsius);
+}
+
+bool temp_history_commit_stage() {
+    if (!initialized) init();
+    bool changed = false;
+    for (int s = 0; s < TEMP_SENSOR_COUNT; s++) {
+        TempHistory* from = &staged[s];
+        TempHistory* to = &histories[s];
+        for (int i = 0; i < TEMP_HISTORY_SLOTS && from->samples; i++) {
+            int16_t v = temp_history_at(from, i);
+            if (v == TEMP_HISTORY_GAP) continue;
+            uint32_t slot = from->newest_slot - (TEMP_HISTORY_SLOTS - 1 - i);
+
+            // Live readings win over the staged ones
+            if (to->samples && slot <= to->newest_slot) {
+                uint32_t age = to->newest_slot - slot;
+                if (age >= TEMP_HISTORY_SLOTS) continue;
+                if (to->value[(to->head + TEMP_HISTORY_SLOTS - age) % TEMP_HISTORY_SLOTS] != TEMP_HISTORY_GAP) continue;
+            }
+            changed |= put(to, slot * TEMP_HISTORY_INTERVAL_S, v / 10.0f);
+        }
+        clear(from);
+    }
+    return changed;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include "config.h"
+
+// Fixed-size 24 h trend per temperature sensor: one int16 value (tenths of
+// a degree C) per TEMP_HISTORY_INTERVAL_S slot in a ring, the oldest slot
+// overwritten. Slot times are implicit (newest slot minus age), so a sensor
+// costs 2 bytes per slot plus a small header and never allocates.
+enum TempSensor {
+    TEMP_INDOOR,
+    TEMP_OUTDOOR,
+    TEMP_SAUNA,
+    TEMP_SENSOR_COUNT
+};
+
+#define TEMP_HISTORY_GAP INT16_MIN   // slot without a sample
+
+struct TempHistory {
+    int16_t  value[TEMP_HISTORY_SLOTS];   // ring, value[head] is the newest slot
+    uint32_t newest_slot;                 // epoch_s / TEMP_HISTORY_INTERVAL_S of value[head]
+    uint16_t head;
+    uint16_t samples;                     // slots holding a value
+    int16_t  min;                         // over all samples (GAP when empty)
+    int16_t  max;
+};
+
+// Store a reading in the slot of epoch_s (the latest reading of a slot wins).
+// Newer slots advance the ring, older ones inside the window fill in place.
+// Returns true when anything the sparkline draws changed.
+bool temp_history_put(TempSensor sensor, uint32_t epoch_s, float celsius);
+void temp_history_clear(TempSensor sensor);
+const TempHistory* temp_history_get(TempSensor sensor);
+
+// Staging for a bulk load on another task (the history backfill): clear,
+// stage into a private copy, then commit on the UI task, which owns the live
+// rings. Slots the live rings already hold keep their value.
+void temp_history_stage_clear();
+bool temp_history_stage(TempSensor sensor, uint32_t epoch_s, float celsius);
+bool temp_history_commit_stage();   // true if anything the sparklines draw changed
+
+// Slot i of the 24 h window, 0 = oldest, TEMP_HISTORY_SLOTS - 1 = newest
+inline int16_t temp_history_at(const TempHistory* h, int i) {
+    return h->value[(h->head + 1 + i) % TEMP_HISTORY_SLOTS];
+}
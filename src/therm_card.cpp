@@ -0,0 +1,310 @@
+#include "therm_card.h"
+#include "ui_fonts.h"
+#include <string.h>
+
+// Fixed layout (px): pad, title, gap, bar, gap, value, pad
+#define TC_PAD      8
+#define TC_GAP      4
+#define TC_BAR_W    20
+#define TC_BAR_H    40
+#define TC_ANIM_MS  200
+#define TC_SPARK_MIN_SPAN 20   // tenths: flatter trends are not stretched to full height
+
+#define TC_TITLE_FONT UI_FONT_14
+#define TC_VALUE_FONT UI_FONT_20
+
+typedef struct {
+    lv_obj_t    obj;
+    const char* title;
+    char        text[16];
+    lv_coord_t  title_w;       // cached text metrics
+    lv_coord_t  text_w;
+    int32_t     min10;         // range in tenths of a degree
+    int32_t     max10;
+    int32_t     value10;       // currently drawn (animated) value
+    lv_color_t  ind_color;
+    lv_color_t  title_color;
+    lv_color_t  text_color;
+    lv_color_t  track_color;
+    const TempHistory* history;   // sparkline source, nullptr = none
+} therm_card_t;
+
+static lv_obj_class_t therm_card_class;
+
+// ----- Sub-rectangles (absolute coordinates) -----
+static void title_area(const therm_card_t* c, lv_area_t* a) {
+    const lv_area_t* co = &c->obj.coords;
+    a->x1 = co->x1 + (lv_area_get_width(co) - c->title_w) / 2;
+    a->x2 = a->x1 + c->title_w - 1;
+    a->y1 = co->y1 + TC_PAD;
+    a->y2 = a->y1 + lv_font_get_line_height(TC_TITLE_FONT) - 1;
+}
+
+static void bar_area(const therm_card_t* c, lv_area_t* a) {
+    const lv_area_t* co = &c->obj.coords;
+    a->x1 = co->x1 + (lv_area_get_width(co) - TC_BAR_W) / 2;
+    a->x2 = a->x1 + TC_BAR_W - 1;
+    a->y1 = co->y1 + TC_PAD + lv_font_get_line_height(TC_TITLE_FONT) + TC_GAP;
+    a->y2 = a->y1 + TC_BAR_H - 1;
+}
+
+static void text_area(const therm_card_t* c, lv_area_t* a) {
+    lv_area_t bar;
+    bar_area(c, &bar);
+    const lv_area_t* co = &c->obj.coords;
+    a->x1 = co->x1 + (lv_area_get_width(co) - c->text_w) / 2;
+    a->x2 = a->x1 + c->text_w - 1;
+    a->y1 = bar.y2 + 1 + TC_GAP;
+    a->y2 = a->y1 + lv_font_get_line_height(TC_VALUE_FONT) - 1;
+}
+
+// Right of the bar, same height
+static void spark_area(const therm_card_t* c, lv_area_t* a) {
+    bar_area(c, a);
+    a->x1 = a->x2 + 1 + TC_PAD;
+    a->x2 = c->obj.coords.x2 - TC_PAD;
+}
+
+static lv_coord_t text_width(const char* text, const lv_font_t* font) {
+    lv_point_t size;
+    lv_txt_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    return size.x;
+}
+
+static void invalidate_bar(therm_card_t* c) {
+    lv_area_t a;
+    bar_area(c, &a);
+    lv_obj_invalidate_area(&c->obj, &a);
+}
+
+// ----- Drawing -----
+// One point per pixel column (min..max of the slots it covers), joined by
+// lines; gaps in the history break the line
+static void draw_sparkline(therm_card_t* c, lv_draw_ctx_t* draw_ctx) {
+    const TempHistory* h = c->history;
+    if (!h || h->samples < 2) return;
+
+    lv_area_t a;
+    spark_area(c, &a);
+    lv_coord_t w = lv_area_get_width(&a);
+    lv_coord_t ht = lv_area_get_height(&a);
+    if (w < 2) return;
+
+    int32_t lo = h->min, hi = h->max;
+    if (hi - lo < TC_SPARK_MIN_SPAN) {
+        int32_t mid = (lo + hi) / 2;
+        lo = mid - TC_SPARK_MIN_SPAN / 2;
+        hi = lo + TC_SPARK_MIN_SPAN;
+    }
+    auto y_of = [&](int32_t v) -> lv_coord_t {
+        return a.y2 - (lv_coord_t)((v - lo) * (ht - 1) / (hi - lo));
+    };
+
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = c->ind_color;
+    dsc.width = 2;
+    dsc.round_start = 1;
+    dsc.round_end = 1;
+
+    bool have_prev = false;
+    lv_point_t prev = {0, 0};
+    for (lv_coord_t x = 0; x < w; x++) {
+        int first = x * TEMP_HISTORY_SLOTS / w;
+        int last  = (x + 1) * TEMP_HISTORY_SLOTS / w;
+        int32_t cmin = INT32_MAX, cmax = INT32_MIN, sum = 0, n = 0;
+        for (int i = first; i < last; i++) {
+            int16_t v = temp_history_at(h, i);
+            if (v == TEMP_HISTORY_GAP) continue;
+            if (v < cmin) cmin = v;
+            if (v > cmax) cmax = v;
+            sum += v;
+            n++;
+        }
+        if (!n) {
+            have_prev = false;
+            continue;
+        }
+        lv_point_t p = {(lv_coord_t)(a.x1 + x), y_of(sum / n)};
+        if (have_prev) lv_draw_line(draw_ctx, &dsc, &prev, &p);
+        if (cmax > cmin) {
+            lv_point_t top = {p.x, y_of(cmax)}, bottom = {p.x, y_of(cmin)};
+            lv_draw_line(draw_ctx, &dsc, &top, &bottom);
+        }
+        prev = p;
+        have_prev = true;
+    }
+}
+
+static void draw_card(therm_card_t* c, lv_draw_ctx_t* draw_ctx) {
+    lv_area_t a;
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.font  = TC_TITLE_FONT;
+    label_dsc.color = c->title_color;
+    title_area(c, &a);
+    lv_draw_label(draw_ctx, &label_dsc, &a, c->title, nullptr);
+
+    // Bar track, then the indicator growing from the bottom
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.radius   = TC_BAR_W / 2;
+    rect_dsc.bg_color = c->track_color;
+    rect_dsc.bg_opa   = LV_OPA_COVER;
+    bar_area(c, &a);
+    lv_draw_rect(draw_ctx, &rect_dsc, &a);
+
+    int32_t span = c->max10 - c->min10;
+    int32_t v = c->value10 < c->min10 ? c->min10 : (c->value10 > c->max10 ? c->max10 : c->value10);
+    int32_t h = span > 0 ? (v - c->min10) * TC_BAR_H / span : 0;
+    if (h > 0) {
+        a.y1 = a.y2 - h + 1;
+        rect_dsc.bg_color = c->ind_color;
+        lv_draw_rect(draw_ctx, &rect_dsc, &a);
+    }
+
+    if (c->text[0]) {
+        label_dsc.font  = TC_VALUE_FONT;
+        label_dsc.color = c->text_color;
+        text_area(c, &a);
+        lv_draw_label(draw_ctx, &label_dsc, &a, c->text, nullptr);
+    }
+
+    draw_sparkline(c, draw_ctx);
+}
+
+// ----- Class callbacks -----
+static void therm_card_constructor(const lv_obj_class_t* class_p, lv_obj_t* obj) {
+    (void)class_p;
+    therm_card_t* c = (therm_card_t*)obj;
+    c->title       = "";
+    c->text[0]     = '\0';
+    c->title_w     = 0;
+    c->text_w      = 0;
+    c->min10       = 0;
+    c->max10       = 1000;
+    c->value10     = 0;
+    c->ind_color   = lv_color_hex(0xF97316);
+    c->title_color = lv_color_hex(0x8B949E);
+    c->text_color  = lv_color_hex(0xFFFFFF);
+    c->track_color = lv_color_hex(0x30363D);
+    c->history     = nullptr;
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void anim_exec_cb(void* var, int32_t v);
+
+static void therm_card_destructor(const lv_obj_class_t* class_p, lv_obj_t* obj) {
+    (void)class_p;
+    lv_anim_del(obj, anim_exec_cb);
+}
+
+static void therm_card_event(const lv_obj_class_t* class_p, lv_event_t* e) {
+    (void)class_p;
+    // Let the base object draw the card background first
+    if (lv_obj_event_base(&therm_card_class, e) != LV_RES_OK) return;
+
+    if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+        therm_card_t* c = (therm_card_t*)lv_event_get_target(e);
+        draw_card(c, lv_event_get_draw_ctx(e));
+    }
+}
+
+static void anim_exec_cb(void* var, int32_t v) {
+    therm_card_t* c = (therm_card_t*)var;
+    c->value10 = v;
+    invalidate_bar(c);
+}
+
+// ----- Public API -----
+lv_obj_t* therm_card_create(lv_obj_t* parent, const char* title) {
+    if (!therm_card_class.base_class) {
+        therm_card_class.base_class     = &lv_obj_class;
+        therm_card_class.constructor_cb = therm_card_constructor;
+        therm_card_class.destructor_cb  = therm_card_destructor;
+        therm_card_class.event_cb       = therm_card_event;
+        therm_card_class.width_def      = LV_PCT(100);
+        therm_card_class.height_def     = THERM_CARD_H;
+        therm_card_class.instance_size  = sizeof(therm_card_t);
+    }
+
+    lv_obj_t* obj = lv_obj_class_create_obj(&therm_card_class, parent);
+    lv_obj_class_init_obj(obj);
+
+    therm_card_t* c = (therm_card_t*)obj;
+    c->title   = title;
+    c->title_w = text_width(title, TC_TITLE_FONT);
+    return obj;
+}
+
+void therm_card_set_range(lv_obj_t* obj, int32_t min, int32_t max) {
+    therm_card_t* c = (therm_card_t*)obj;
+    c->min10 = min * 10;
+    c->max10 = max * 10;
+    invalidate_bar(c);
+}
+
+void therm_card_set_value(lv_obj_t* obj, float value, lv_color_t color, bool anim) {
+    therm_card_t* c = (therm_card_t*)obj;
+    int32_t target = (int32_t)(value * 10.0f + (value < 0 ? -0.5f : 0.5f));
+
+    if (c->ind_color.full != color.full) {
+        c->ind_color = color;
+        invalidate_bar(c);
+        if (c->history) therm_card_history_changed(obj);
+    }
+    if (target == c->value10) return;
+
+    lv_anim_del(c, anim_exec_cb);
+    if (!anim) {
+        anim_exec_cb(c, target);
+        return;
+    }
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, c);
+    lv_anim_set_exec_cb(&a, anim_exec_cb);
+    lv_anim_set_values(&a, c->value10, target);
+    lv_anim_set_time(&a, TC_ANIM_MS);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+    lv_anim_start(&a);
+}
+
+void therm_card_set_text(lv_obj_t* obj, const char* text) {
+    therm_card_t* c = (therm_card_t*)obj;
+    if (strcmp(c->text, text) == 0) return;
+
+    // Invalidate the union of the old and new text rectangles only
+    lv_area_t old_area, new_area;
+    text_area(c, &old_area);
+    strncpy(c->text, text, sizeof(c->text) - 1);
+    c->text[sizeof(c->text) - 1] = '\0';
+    c->text_w = text_width(c->text, TC_VALUE_FONT);
+    text_area(c, &new_area);
+
+    _lv_area_join(&old_area, &old_area, &new_area);
+    lv_obj_invalidate_area(obj, &old_area);
+}
+
+void therm_card_set_colors(lv_obj_t* obj, lv_color_t title, lv_color_t text, lv_color_t track) {
+    therm_card_t* c = (therm_card_t*)obj;
+    c->title_color = title;
+    c->text_color  = text;
+    c->track_color = track;
+    lv_obj_invalidate(obj);
+}
+
+void therm_card_set_history(lv_obj_t* obj, const TempHistory* history) {
+    therm_card_t* c = (therm_card_t*)obj;
+    c->history = history;
+    therm_card_history_changed(obj);
+}
+
+void therm_card_history_changed(lv_obj_t* obj) {
+    lv_area_t a;
+    spark_area((therm_card_t*)obj, &a);
+    lv_obj_invalidate_area(obj, &a);
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <lvgl.h>
+#include "temp_history.h"
+
+// Thermometer card: title, rounded bar and value text drawn by one object
+// with a fixed layout, plus a 24 h sparkline right of the bar. Updates
+// invalidate only the sub-rectangle that changed.
+#define THERM_CARD_H 100
+
+lv_obj_t* therm_card_create(lv_obj_t* parent, const char* title);  // title must be static
+void therm_card_set_range(lv_obj_t* obj, int32_t min, int32_t max);
+void therm_card_set_value(lv_obj_t* obj, float value, lv_color_t color, bool anim);
+void therm_card_set_text(lv_obj_t* obj, const char* text);
+void therm_card_set_colors(lv_obj_t* obj, lv_color_t title, lv_color_t text, lv_color_t track);
+void therm_card_set_history(lv_obj_t* obj, const TempHistory* history);  // must outlive the card
+void therm_card_history_changed(lv_obj_t* obj);   // redraws only the sparkline
@@ -0,0 +1,250 @@
+#include "tiered_alloc.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef SIMULATOR
+#include <esp_heap_caps.h>
+#endif
+
+static const char* TAG = "ALLOC";
+
+// Block counts are sized from the peaks bench "alloc" reports for the
+// dashboard, with headroom; a full class spills to the bulk heap.
+static const struct {
+    uint16_t size;
+    uint16_t count;
+} CLASSES[TIERED_CLASS_COUNT] = {
+    {16, 384}, {24, 384}, {32, 256}, {48, 160}, {64, 128}, {96, 64}, {128, 48},
+};
+
+typedef struct free_block {
+    struct free_block* next;
+} free_block_t;
+
+typedef struct {
+    uint8_t*      start;      // slab inside the arena
+    uint8_t*      end;
+    free_block_t* free_list;
+    uint8_t*      requested;  // bytes asked for, per block (for waste stats)
+} pool_t;
+
+// Bulk blocks carry their size in front so stats survive free/realloc
+#define BULK_HDR ((sizeof(size_t) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1))
+
+static bool     initialized = false;
+static uint8_t* arena = nullptr;
+static uint8_t* arena_end = nullptr;
+static pool_t   pools[TIERED_CLASS_COUNT];
+static uint8_t  class_for_size[TIERED_POOL_MAX / 8 + 1];   // (size + 7) / 8 -> class
+static tiered_stats_t stats;
+
+static void* sram_alloc(size_t size) {
+#ifdef SIMULATOR
+    return malloc(size);
+#else
+    return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#endif
+}
+
+static void init() {
+    initialized = true;
+    size_t bytes = 0;
+    for (int c = 0; c < TIERED_CLASS_COUNT; c++) bytes += (size_t)CLASSES[c].size * CLASSES[c].count;
+
+    int c = 0;
+    for (size_t s = 0; s <= TIERED_POOL_MAX / 8; s++) {
+        while (CLASSES[c].size < s * 8) c++;
+        class_for_size[s] = c;
+    }
+
+    arena = (uint8_t*)sram_alloc(bytes);
+    size_t total_blocks = 0;
+    for (c = 0; c < TIERED_CLASS_COUNT; c++) total_blocks += CLASSES[c].count;
+    uint8_t* requested = (uint8_t*)sram_alloc(total_blocks);
+    if (!arena || !requested) {
+        free(arena);
+        free(requested);
+        arena = nullptr;
+        Serial.printf("[%s] no internal RAM for the %u byte pool, bulk heap only\n", TAG, (unsigned)bytes);
+        return;
+    }
+    memset(requested, 0, total_blocks);
+
+    uint8_t* p = arena;
+    for (c = 0; c < TIERED_CLASS_COUNT; c++) {
+        pool_t* pool = &pools[c];
+        pool->start = p;
+        pool->end = p + (size_t)CLASSES[c].size * CLASSES[c].count;
+        pool->requested = requested;
+        requested += CLASSES[c].count;
+        // Thread the free list in address order
+        pool->free_list = nullptr;
+        for (int i = CLASSES[c].count - 1; i >= 0; i--) {
+            free_block_t* b = (free_block_t*)(pool->start + (size_t)i * CLASSES[c].size);
+            b->next = pool->free_list;
+            pool->free_list = b;
+        }
+        stats.classes[c].block_size = CLASSES[c].size;
+        stats.classes[c].capacity = CLASSES[c].count;
+        p = pool->end;
+    }
+    arena_end = p;
+    stats.pool_bytes = bytes;
+}
+
+static int pool_of(const void* ptr) {
+    const uint8_t* p = (const uint8_t*)ptr;
+    if (p < arena || p >= arena_end) return -1;
+    for (int c = 0; c < TIERED_CLASS_COUNT; c++) {
+        if (p < pools[c].end) return c;
+    }
+    return -1;
+}
+
+static void* bulk_alloc(size_t size) {
+    size_t* hdr = nullptr;
+#ifdef SIMULATOR
+    hdr = (size_t*)malloc(BULK_HDR + size);
+#else
+    hdr = (size_t*)heap_caps_malloc(BULK_HDR + size, MALLOC_CAP_SPIRAM);
+    if (!hdr) {
+        hdr = (size_t*)heap_caps_malloc(BULK_HDR + size, MALLOC_CAP_8BIT);
+        if (hdr) stats.bulk_internal++;
+    }
+#endif
+    if (!hdr) return nullptr;
+    *hdr = size;
+    stats.bulk_used += size;
+    if (stats.bulk_used > stats.bulk_peak) stats.bulk_peak = stats.bulk_used;
+    stats.bulk_live++;
+    stats.bulk_allocs++;
+    return (uint8_t*)hdr + BULK_HDR;
+}
+
+static void bulk_free(void* ptr) {
+    size_t* hdr = (size_t*)((uint8_t*)ptr - BULK_HDR);
+    stats.bulk_used -= *hdr;
+    stats.bulk_live--;
+    free(hdr);
+}
+
+extern "C" void* tiered_malloc(size_t size) {
+    if (!initialized) init();
+
+    if (size <= TIERED_POOL_MAX && arena) {
+        int c = class_for_size[(size + 7) / 8];
+        pool_t* pool = &pools[c];
+        tiered_class_stats_t* cs = &stats.classes[c];
+        free_block_t* b = pool->free_list;
+        if (b) {
+            pool->free_list = b->next;
+            pool->requested[((uint8_t*)b - pool->start) / CLASSES[c].size] = (uint8_t)size;
+            cs->used++;
+            if (cs->used > cs->peak) cs->peak = cs->used;
+            cs->allocs++;
+            cs->requested += size;
+            return b;
+        }
+        cs->overflows++;
+    }
+    return bulk_alloc(size);
+}
+
+extern "C" void tiered_free(void* ptr) {
+    if (!ptr) return;
+    int c = pool_of(ptr);
+    if (c < 0) {
+        bulk_free(ptr);
+        return;
+    }
+    pool_t* pool = &pools[c];
+    tiered_class_stats_t* cs = &stats.classes[c];
+    uint8_t* req = &pool->requested[((uint8_t*)ptr - pool->start) / CLASSES[c].size];
+    cs->requested -= *req;
+    *req = 0;
+    cs->used--;
+    ((free_block_t*)ptr)->next = pool->free_list;
+    pool->free_list = (free_block_t*)ptr;
+}
+
+extern "C" void* tiered_realloc(void* ptr, size_t size) {
+    if (!ptr) return tiered_malloc(size);
+    if (size == 0) {
+        tiered_free(ptr);
+        return nullptr;
+    }
+
+    size_t old_size;
+    int c = pool_of(ptr);
+    if (c >= 0) {
+        // Still fits the same class: keep the block
+        if (size <= TIERED_POOL_MAX && class_for_size[(size + 7) / 8] == c) {
+            pool_t* pool = &pools[c];
+            uint8_t* req = &pool->requested[((uint8_t*)ptr - pool->start) / CLASSES[c].size];
+            stats.classes[c].requested += size - *req;
+            *req = (uint8_t)size;
+            return ptr;
+        }
+        old_size = CLASSES[c].size;
+    } else {
+        old_size = *(size_t*)((uint8_t*)ptr - BULK_HDR);
+        if (size > TIERED_POOL_MAX) {
+            // Bulk to bulk: let the heap grow in place when it can
+            size_t* hdr = (size_t*)((uint8_t*)ptr - BULK_HDR);
+#ifdef SIMULATOR
+            size_t* grown = (size_t*)realloc(hdr, BULK_HDR + size);
+#else
+            size_t* grown = (size_t*)heap_caps_realloc(hdr, BULK_HDR + size, MALLOC_CAP_SPIRAM);
+            if (!grown) grown = (size_t*)realloc(hdr, BULK_HDR + size);
+#endif
+            if (!grown) return nullptr;
+            *grown = size;
+            stats.bulk_used += size - old_size;
+            if (stats.bulk_used > stats.bulk_peak) stats.bulk_peak = stats.bulk_used;
+            return (uint8_t*)grown + BULK_HDR;
+        }
+    }
+
+    void* moved = tiered_malloc(size);
+    if (!moved) return nullptr;
+    memcpy(moved, ptr, old_size < size ? old_size : size);
+    tiered_free(ptr);
+    return moved;
+}
+
+extern "C" void tiered_alloc_get_stats(tiered_stats_t* out) {
+    if (!initialized) init();
+    size_t block_bytes = 0;
+    size_t requested = 0;
+    for (int c = 0; c < TIERED_CLASS_COUNT; c++) {
+        block_bytes += (size_t)stats.classes[c].used * stats.classes[c].block_size;
+        requested += stats.classes[c].requested;
+    }
+    stats.pool_used = block_bytes;
+    stats.pool_waste_pct = block_bytes ? (uint8_t)(100 - requested * 100 / block_bytes) : 0;
+
+#ifdef SIMULATOR
+    stats.heap_free = 0;
+    stats.heap_largest = 0;
+#else
+    stats.heap_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    stats.heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+#endif
+    stats.heap_frag_pct = stats.heap_free ? (uint8_t)(100 - stats.heap_largest * 100 / stats.heap_free) : 0;
+    *out = stats;
+}
+
+extern "C" void tiered_alloc_dump(void) {
+    tiered_stats_t s;
+    tiered_alloc_get_stats(&s);
+    Serial.printf("[%s] pool %u/%u bytes (%u%% waste), bulk %u bytes in %lu blocks (peak %u), heap frag %u%%\n",
+                  TAG, (unsigned)s.pool_used, (unsigned)s.pool_bytes, s.pool_waste_pct,
+                  (unsigned)s.bulk_used, (unsigned long)s.bulk_live, (unsigned)s.bulk_peak, s.heap_frag_pct);
+    for (int c = 0; c < TIERED_CLASS_COUNT; c++) {
+        const tiered_class_stats_t* cs = &s.classes[c];
+        Serial.printf("[%s]   %3u B: %4u/%-4u used, peak %4u, %6lu allocs, %5lu overflows\n",
+                      TAG, cs->block_size, cs->used, cs->capacity, cs->peak,
+                      (unsigned long)cs->allocs, (unsigned long)cs->overflows);
+    }
+}
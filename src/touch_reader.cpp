@@ -0,0 +1,90 @@
+#include "touch_reader.h"
+#include "config.h"
+#include "event_loop.h"
+#include "input_latency.h"
+#include <Arduino.h>
+#include <atomic>
+
+static lv_indev_drv_t* reader_drv = nullptr;
+static touch_read_fn   controller_read = nullptr;
+static bool            irq_mode = false;
+
+static std::atomic<bool> irq_pending(false);
+static bool     pressed = false;
+static bool     timer_paused = false;
+static int16_t  last_x = 0;
+static int16_t  last_y = 0;
+static uint32_t last_read_ms = 0;
+
+static TouchReaderStats stats = {};
+static std::atomic<uint32_t> irq_count(0);
+
+static void read_controller(uint32_t now) {
+    bool was_pressed = pressed;
+    pressed = controller_read(&last_x, &last_y);
+    if (pressed != was_pressed) input_latency_read(pressed);
+    last_read_ms = now;
+    stats.reads++;
+}
+
+static void read_cb(lv_indev_drv_t* drv, lv_indev_data_t* data) {
+    uint32_t now = lv_tick_get();
+
+    if (!irq_mode) {
+        read_controller(now);
+    } else if (irq_pending.exchange(false)) {
+        read_controller(now);
+    } else if (pressed && lv_tick_elaps(last_read_ms) >= TOUCH_RELEASE_MS) {
+        read_controller(now);
+    }
+
+    data->state   = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->point.x = last_x;
+    data->point.y = last_y;
+
+    // Released and nothing coasting: LVGL has no more work for this indev.
+    // A scroll throw keeps running on indev reads, so wait for it to end.
+    if (irq_mode && !pressed && !irq_pending.load() && drv->read_timer) {
+        lv_indev_t* indev = lv_indev_get_act();
+        if (!indev || !lv_indev_get_scroll_obj(indev)) {
+            lv_timer_pause(drv->read_timer);
+            timer_paused = true;
+        }
+    }
+}
+
+// Loop task: an IRQ arrived while the read timer was paused
+static void wake_hook() {
+    if (!timer_paused || !irq_pending.load() || !reader_drv->read_timer) return;
+    timer_paused = false;
+    lv_timer_resume(reader_drv->read_timer);
+    lv_timer_ready(reader_drv->read_timer);
+    stats.resumes++;
+}
+
+// May be called again on the same driver to switch modes (bench)
+void touch_reader_init(lv_indev_drv_t* drv, touch_read_fn read, bool use_irq) {
+    static bool hooked = false;
+    reader_drv      = drv;
+    controller_read = read;
+    irq_mode        = use_irq;
+    drv->read_cb    = read_cb;
+    if (timer_paused && drv->read_timer) lv_timer_resume(drv->read_timer);
+    timer_paused = false;
+    if (use_irq && !hooked) {
+        event_loop_on_wake(wake_hook);
+        hooked = true;
+    }
+}
+
+void IRAM_ATTR touch_reader_irq() {
+    input_latency_edge();
+    irq_pending.store(true);
+    irq_count.fetch_add(1, std::memory_order_relaxed);
+    event_loop_wake_from_isr();
+}
+
+void touch_reader_get_stats(TouchReaderStats& out) {
+    out = stats;
+    out.irqs = irq_count.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <lvgl.h>
+#include <stdint.h>
+
+// Pointer input read state machine, shared by the GT911 driver (touch.cpp)
+// and the simulator's mock controller so it runs the same code in both.
+//
+// Polling mode calls the controller read on every indev period. IRQ mode
+// reads only after touch_reader_irq() (the controller's INT line), re-reads
+// every TOUCH_RELEASE_MS while pressed in case the release edge is missed,
+// and pauses the indev read timer once released and no scroll is coasting.
+// The next IRQ resumes it from the event loop, so an untouched panel costs
+// no I2C traffic and no loop wakeups.
+
+// One controller transaction; true and the mapped point while touched
+typedef bool (*touch_read_fn)(int16_t* x, int16_t* y);
+
+struct TouchReaderStats {
+    uint32_t reads;      // controller transactions
+    uint32_t irqs;       // INT edges
+    uint32_t resumes;    // indev timer resumed from idle
+};
+
+// Sets drv->read_cb; register the driver with lv_indev_drv_register() after
+void touch_reader_init(lv_indev_drv_t* drv, touch_read_fn read, bool use_irq);
+
+void touch_reader_irq();   // ISR-safe: controller has new data
+void touch_reader_get_stats(TouchReaderStats& out);
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <stdint.h>
+
+// Lock-free snapshot exchange between one producer and one consumer task.
+// The producer fills back() and publish()es it; the consumer fetch()es the
+// latest published buffer into front(). Each side owns its buffer outright
+// until it swaps it through the shared middle slot with a single atomic
+// exchange, so neither ever waits and the consumer always sees a complete
+// snapshot. Intermediate snapshots may be skipped: generations count every
+// publish, so the consumer can tell how many it missed.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : buf_(), gen_(), middle_(1), back_(0), front_(2), published_(0) {}
+
+    // ----- Producer -----
+    T& back() { return buf_[back_]; }
+
+    // Hand back() to the consumer; returns its generation (1, 2, ..)
+    uint32_t publish() {
+        uint32_t g = ++published_;
+        gen_[back_] = g;
+        back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+        return g;
+    }
+
+    // ----- Consumer -----
+    // Switch front() to the newest snapshot; false if nothing new was published
+    bool fetch() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    const T& front() const { return buf_[front_]; }
+    uint32_t generation() const { return gen_[front_]; }   // 0 until the first fetch
+
+private:
+    static constexpr uint8_t INDEX = 0x03;
+    static constexpr uint8_t FRESH = 0x04;   // middle holds a snapshot not fetched yet
+
+    T        buf_[3];
+    uint32_t gen_[3];                // written by the producer before the exchange
+    std::atomic<uint8_t> middle_;    // index of the shared buffer | FRESH
+    uint8_t  back_;                  // producer only
+    uint8_t  front_;                 // consumer only
+    uint32_t published_;             // producer only
+};
@@ -0,0 +1,465 @@
+#include "ts_store.h"
+#include "config.h"
+#include "serial_console.h"
+#include <Arduino.h>
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef SIMULATOR
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <esp_partition.h>
+#endif
+
+static const char* TAG = "TSDB";
+
+#define TS_MAGIC      0x42445354u   // "TSDB"
+#define TS_FREE       0xFF          // erased flash
+#define TS_MAX_RECORD 11            // series + two 5-byte varints
+#define TS_NO_TIME    0xFFFFFFFFu
+
+// Written right after the erase; first_s is programmed with the first record
+struct SectorHeader {
+    uint32_t magic;
+    uint32_t seq;           // increases by one per sector started
+    uint32_t erase_count;
+    uint32_t first_s;       // time of the first record, TS_NO_TIME while empty
+};
+
+static const uint8_t* base = nullptr;   // mapped partition
+static uint32_t sector_count = 0;
+static int      active = -1;
+static uint32_t write_off = 0;          // inside the active sector
+static uint32_t base_t[TS_STORE_MAX_SERIES];   // delta bases in the active sector
+static int32_t  base_v[TS_STORE_MAX_SERIES];
+
+// The active sector is built in RAM and programmed a whole page at a time
+static uint8_t  image[TS_STORE_SECTOR];
+static uint32_t prog_off = 0;           // image bytes already in flash
+static bool     erased = false;         // active sector erased since it was started
+static uint32_t flash_writes = 0, flash_erases = 0;
+
+// ----- Flash access -----
+#ifdef SIMULATOR
+static int    fd = -1;
+static size_t map_size = 0;
+
+static bool flash_write(uint32_t off, const void* data, size_t len) {
+    flash_writes++;
+    return pwrite(fd, data, len, off) == (ssize_t)len;
+}
+
+static bool flash_erase(uint32_t off) {
+    uint8_t ff[TS_STORE_SECTOR];
+    memset(ff, TS_FREE, sizeof(ff));
+    flash_erases++;
+    return pwrite(fd, ff, sizeof(ff), off) == (ssize_t)sizeof(ff);
+}
+#else
+static const esp_partition_t* part = nullptr;
+static spi_flash_mmap_handle_t map_handle;
+
+static bool flash_write(uint32_t off, const void* data, size_t len) {
+    flash_writes++;
+    return esp_partition_write(part, off, data, len) == ESP_OK;
+}
+
+static bool flash_erase(uint32_t off) {
+    flash_erases++;
+    return esp_partition_erase_range(part, off, TS_STORE_SECTOR) == ESP_OK;
+}
+#endif
+
+// The active sector reads from its RAM image, which is ahead of the flash
+static const uint8_t* sector_data(int s) {
+    return s == active ? image : base + (size_t)s * TS_STORE_SECTOR;
+}
+
+static const SectorHeader* header(int s) {
+    return (const SectorHeader*)sector_data(s);
+}
+
+static bool sector_valid(int s) {
+    return header(s)->magic == TS_MAGIC;
+}
+
+// ----- Encoding -----
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static uint8_t* put_varint(uint8_t* p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)v | 0x80;
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+static bool get_varint(const uint8_t*& p, const uint8_t* end, uint32_t& out) {
+    out = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        out |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ----- Decoding a sector -----
+struct Cursor {
+    const uint8_t* p;
+    const uint8_t* end;
+    uint32_t t[TS_STORE_MAX_SERIES];
+    int32_t  v[TS_STORE_MAX_SERIES];
+    bool     torn;   // stopped at a damaged length byte, not at erased flash
+};
+
+static void cursor_init(Cursor& c, int s) {
+    memset(&c, 0, sizeof(c));
+    c.p   = sector_data(s) + sizeof(SectorHeader);
+    c.end = sector_data(s) + TS_STORE_SECTOR;
+}
+
+// Next intact record; one cut short by a reset is skipped without touching the bases
+static bool next_record(Cursor& c, uint8_t& series, uint32_t& t, int32_t& v) {
+    while (c.p < c.end && *c.p != TS_FREE) {
+        uint8_t len = *c.p;
+        const uint8_t* rec = c.p + 1;
+        if (len < 3 || len > TS_MAX_RECORD || rec + len > c.end) {
+            c.torn = true;
+            return false;
+        }
+        c.p = rec + len;
+
+        const uint8_t* q = rec;
+        uint8_t s = *q++;
+        uint32_t zt, zv;
+        if (s >= TS_STORE_MAX_SERIES || !get_varint(q, c.p, zt) || !get_varint(q, c.p, zv) || q != c.p) continue;
+        c.t[s] += (uint32_t)unzigzag(zt);
+        c.v[s] += unzigzag(zv);
+        series = s;
+        t = c.t[s];
+        v = c.v[s];
+        return true;
+    }
+    return false;
+}
+
+// ----- Sectors -----
+// Programs the image up to `end`. The sector is erased right before its
+// first page goes out, so until then the flash still holds the old data.
+static bool program(uint32_t end) {
+    if (end <= prog_off) return true;
+    uint32_t sector_off = (uint32_t)active * TS_STORE_SECTOR;
+    if (!erased) {
+        if (!flash_erase(sector_off)) return false;
+        erased = true;
+        prog_off = 0;
+    } else if (prog_off >= sizeof(SectorHeader)) {
+        // The header went out with an earlier flush, maybe before the first record
+        const SectorHeader* flashed = (const SectorHeader*)(base + sector_off);
+        uint32_t first_s = header(active)->first_s;
+        if (flashed->first_s != first_s &&
+            !flash_write(sector_off + offsetof(SectorHeader, first_s), &first_s, sizeof(first_s)))
+            return false;
+    }
+    if (!flash_write(sector_off + prog_off, image + prog_off, end - prog_off)) return false;
+    prog_off = end;
+    return true;
+}
+
+// Starts sector s in RAM only; nothing is erased until its first page is full
+static void start_sector(int s, uint32_t seq) {
+    SectorHeader h = {TS_MAGIC, seq, sector_valid(s) ? header(s)->erase_count + 1 : 1, TS_NO_TIME};
+    memset(image, TS_FREE, sizeof(image));
+    memcpy(image, &h, sizeof(h));
+    active = s;
+    write_off = sizeof(SectorHeader);
+    prog_off = 0;
+    erased = false;
+    memset(base_t, 0, sizeof(base_t));
+    memset(base_v, 0, sizeof(base_v));
+}
+
+// Newest sector, write position after its last record and the delta bases
+static void mount() {
+    active = -1;
+    flash_writes = flash_erases = 0;
+    int newest = -1;   // headers read from flash while no sector is active
+    for (uint32_t s = 0; s < sector_count; s++) {
+        if (sector_valid(s) && (newest < 0 || header(s)->seq > header(newest)->seq)) newest = s;
+    }
+    if (newest < 0) {
+        start_sector(0, 1);
+        return;
+    }
+    memcpy(image, base + (size_t)newest * TS_STORE_SECTOR, TS_STORE_SECTOR);
+    active = newest;
+    erased = true;
+
+    Cursor c;
+    cursor_init(c, active);
+    uint8_t series;
+    uint32_t t;
+    int32_t v;
+    while (next_record(c, series, t, v)) {}
+    // Never write over a damaged tail: continue in a fresh sector
+    write_off = c.torn ? TS_STORE_SECTOR : (uint32_t)(c.p - image);
+    prog_off = write_off;
+    memcpy(base_t, c.t, sizeof(base_t));
+    memcpy(base_v, c.v, sizeof(base_v));
+}
+
+// ----- Public API -----
+bool ts_store_append(uint8_t series, uint32_t t, int32_t value) {
+    if (!base || active < 0 || series >= TS_STORE_MAX_SERIES) return false;
+
+    uint8_t rec[1 + TS_MAX_RECORD];
+    auto encode = [&]() -> size_t {
+        uint8_t* p = rec + 1;
+        *p++ = series;
+        p = put_varint(p, zigzag((int32_t)(t - base_t[series])));
+        p = put_varint(p, zigzag(value - base_v[series]));
+        rec[0] = (uint8_t)(p - rec - 1);
+        return p - rec;
+    };
+
+    size_t len = encode();
+    if (write_off + len > TS_STORE_SECTOR) {
+        // Rotate: the next sector in the ring is the oldest
+        if (!ts_store_flush()) return false;
+        start_sector((active + 1) % sector_count, header(active)->seq + 1);
+        len = encode();   // bases restart at zero
+    }
+
+    memcpy(image + write_off, rec, len);
+    if (header(active)->first_s == TS_NO_TIME) ((SectorHeader*)image)->first_s = t;
+    write_off += len;
+    base_t[series] = t;
+    base_v[series] = value;
+
+    uint32_t full = write_off / TS_STORE_PAGE * TS_STORE_PAGE;
+    return full <= prog_off || program(full);
+}
+
+bool ts_store_flush() {
+    if (!base || active < 0) return false;
+    return program(write_off);
+}
+
+uint32_t ts_store_scan(uint8_t series, uint32_t from_s, uint32_t to_s, ts_store_visit_fn fn, void* ctx) {
+    if (!base || active < 0) return 0;
+    uint32_t visited = 0;
+
+    // Ring order, oldest first: the sector after the active one
+    for (uint32_t i = 1; i <= sector_count; i++) {
+        int s = (active + i) % sector_count;
+        if (!sector_valid(s) || header(s)->first_s == TS_NO_TIME) continue;
+        if (header(s)->first_s > to_s) break;
+
+        // Entirely before the range if the next sector starts before it
+        int n = (s + 1) % sector_count;
+        if (s != active && sector_valid(n) && header(n)->first_s != TS_NO_TIME && header(n)->first_s < from_s) continue;
+
+        Cursor c;
+        cursor_init(c, s);
+        uint8_t rs;
+        uint32_t t;
+        int32_t v;
+        while (next_record(c, rs, t, v)) {
+            if (rs != series || t < from_s || t > to_s) continue;
+            fn(ctx, t, v);
+            visited++;
+        }
+    }
+    return visited;
+}
+
+void ts_store_get_stats(TsStoreStats& out) {
+    memset(&out, 0, sizeof(out));
+    out.sectors = sector_count;
+    if (!base) return;
+    out.erase_min = UINT32_MAX;
+    out.oldest_s = UINT32_MAX;
+    for (uint32_t s = 0; s < sector_count; s++) {
+        if (!sector_valid(s)) {
+            out.erase_min = 0;
+            continue;
+        }
+        const SectorHeader* h = header(s);
+        if (h->erase_count < out.erase_min) out.erase_min = h->erase_count;
+        if (h->erase_count > out.erase_max) out.erase_max = h->erase_count;
+        if (h->first_s == TS_NO_TIME) continue;
+
+        out.sectors_used++;
+        Cursor c;
+        cursor_init(c, s);
+        uint8_t series;
+        uint32_t t;
+        int32_t v;
+        while (next_record(c, series, t, v)) {
+            out.records++;
+            if (t < out.oldest_s) out.oldest_s = t;
+            if (t > out.newest_s) out.newest_s = t;
+        }
+        out.bytes_used += c.p - sector_data(s);
+    }
+    out.unflushed = write_off - prog_off;
+    out.flash_writes = flash_writes;
+    out.flash_erases = flash_erases;
+    if (out.erase_min == UINT32_MAX) out.erase_min = 0;
+    if (out.oldest_s == UINT32_MAX) out.oldest_s = 0;
+}
+
+void ts_store_format() {
+    if (!base) return;
+    active = -1;
+    for (uint32_t s = 0; s < sector_count; s++) {
+        if (header(s)->magic != 0xFFFFFFFFu || header(s)->first_s != TS_NO_TIME) flash_erase(s * TS_STORE_SECTOR);
+    }
+    start_sector(0, 1);
+    erased = true;
+}
+
+// ----- Backends -----
+#ifdef SIMULATOR
+void ts_store_close() {
+    ts_store_flush();
+    if (base) munmap((void*)base, map_size);
+    if (fd >= 0) close(fd);
+    base = nullptr;
+    fd = -1;
+    active = -1;
+}
+
+bool ts_store_open_file(const char* path, size_t size) {
+    ts_store_close();
+    size -= size % TS_STORE_SECTOR;
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+
+    struct stat st;
+    fstat(fd, &st);
+    if ((size_t)st.st_size != size) {
+        // New file (or resized): erased flash is all ones
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, size) != 0) return false;
+        sector_count = size / TS_STORE_SECTOR;
+        for (uint32_t s = 0; s < sector_count; s++) flash_erase(s * TS_STORE_SECTOR);
+    }
+    void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        fd = -1;
+        return false;
+    }
+    base = (const uint8_t*)p;
+    map_size = size;
+    sector_count = size / TS_STORE_SECTOR;
+    mount();
+    return true;
+}
+
+static bool open_backend() {
+    return ts_store_open_file(TS_STORE_SIM_FILE, TS_STORE_SIM_SIZE);
+}
+#else
+static bool open_backend() {
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x40, "tsdb");
+    if (!part) return false;
+    const void* p = nullptr;
+    if (esp_partition_mmap(part, 0, part->size, SPI_FLASH_MMAP_DATA, &p, &map_handle) != ESP_OK) return false;
+    base = (const uint8_t*)p;
+    sector_count = part->size / TS_STORE_SECTOR;
+    mount();
+    return true;
+}
+#endif
+
+// ----- Serial command -----
+struct RangeSummary {
+    uint32_t n;
+    int32_t  min, max;
+    int64_t  sum;
+};
+
+static void summarize(void* ctx, uint32_t t, int32_t v) {
+    (void)t;
+    RangeSummary* r = (RangeSummary*)ctx;
+    if (!r->n || v < r->min) r->min = v;
+    if (!r->n || v > r->max) r->max = v;
+    r->sum += v;
+    r->n++;
+}
+
+static void run_ts(const char* args) {
+    if (strcmp(args, "flush") == 0) {
+        ts_store_flush();
+    } else if (args[0]) {
+        // "ts <series> <hours>": min/avg/max of the last hours
+        char* end;
+        long series = strtol(args, &end, 10);
+        long hours = strtol(end, nullptr, 10);
+        if (hours <= 0) hours = 24;
+        TsStoreStats st;
+        ts_store_get_stats(st);
+        RangeSummary r = {};
+        uint32_t t0 = micros();
+        uint32_t span = (uint32_t)hours * 3600;
+        ts_store_scan((uint8_t)series, st.newest_s > span ? st.newest_s - span : 0, st.newest_s, summarize, &r);
+        Serial.printf("[%s] series %ld, %ld h: %lu samples, min %ld avg %.1f max %ld (%lu us)\n", TAG, series,
+                      hours, (unsigned long)r.n, (long)r.min, r.n ? (double)r.sum / r.n : 0.0, (long)r.max,
+                      (unsigned long)(micros() - t0));
+        return;
+    }
+    TsStoreStats st;
+    ts_store_get_stats(st);
+    Serial.printf("[%s] %lu/%lu sectors, %lu records in %lu bytes, %.1f days, erases %lu..%lu\n", TAG,
+                  (unsigned long)st.sectors_used, (unsigned long)st.sectors, (unsigned long)st.records,
+                  (unsigned long)st.bytes_used, (st.newest_s - st.oldest_s) / 86400.0,
+                  (unsigned long)st.erase_min, (unsigned long)st.erase_max);
+    Serial.printf("[%s] %lu bytes not yet in flash; %lu writes, %lu erases since boot\n", TAG,
+                  (unsigned long)st.unflushed, (unsigned long)st.flash_writes, (unsigned long)st.flash_erases);
+}
+
+// Only the net task touches the store: the console queues the command
+static char queued_args[32];
+static std::atomic<bool> queued(false);
+
+static void cmd_ts(const char* args) {
+    if (queued.load(std::memory_order_acquire)) {
+        Serial.printf("[%s] previous command still queued\n", TAG);
+        return;
+    }
+    snprintf(queued_args, sizeof(queued_args), "%s", args);
+    queued.store(true, std::memory_order_release);
+    Serial.printf("[%s] queued, runs with the next poll\n", TAG);
+}
+
+void ts_store_poll() {
+    if (!queued.load(std::memory_order_acquire)) return;
+    run_ts(queued_args);
+    queued.store(false, std::memory_order_release);
+}
+
+bool ts_store_init() {
+    serial_console_add("ts", "flash sample log: ts [series hours | flush]", cmd_ts);
+    if (!open_backend()) {
+        Serial.printf("[%s] no tsdb partition, long-term history disabled\n", TAG);
+        return false;
+    }
+    TsStoreStats st;
+    ts_store_get_stats(st);
+    Serial.printf("[%s] %lu records in %lu/%lu sectors\n", TAG, (unsigned long)st.records,
+                  (unsigned long)st.sectors_used, (unsigned long)st.sectors);
+    return true;
+}
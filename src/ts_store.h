@@ -0,0 +1,53 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// Long-term sample log in flash. Records are appended to 4 KB sectors used
+// as a ring; the oldest sector is erased when the log wraps, so every sector
+// wears evenly (erase counts are kept in the sector headers). A record is a
+// length byte followed by the series id and the zigzag varint deltas of
+// time and value against the previous record of that series in the same
+// sector, typically 4 bytes. Reads decode straight from the memory-mapped
+// partition (a mapped file in the simulator) without copying.
+//
+// Every flash write or erase stalls the cache on both cores, and the RGB
+// panel scans its framebuffer out of PSRAM through that cache. So the active
+// sector is built in a RAM image and programmed one whole TS_STORE_PAGE at a
+// time (about every 10 min at 3 readings per 30 s), and a recycled sector is
+// only erased when its first page goes out. The price: a reset loses the
+// records not yet programmed, up to one page. ts_store_flush() programs them
+// early, e.g. before a planned restart.
+//
+// Not thread-safe: appends, scans and flushes all run on one task (the net
+// task). The "ts" serial command is only queued by the console and runs from
+// ts_store_poll() on that task.
+#define TS_STORE_MAX_SERIES 8
+
+struct TsStoreStats {
+    uint32_t sectors;
+    uint32_t sectors_used;
+    uint32_t records;
+    uint32_t bytes_used;
+    uint32_t erase_min;
+    uint32_t erase_max;
+    uint32_t oldest_s;
+    uint32_t newest_s;
+    uint32_t unflushed;      // bytes only in RAM, lost on reset
+    uint32_t flash_writes;   // since the store was opened
+    uint32_t flash_erases;
+};
+
+typedef void (*ts_store_visit_fn)(void* ctx, uint32_t t, int32_t value);
+
+bool ts_store_init();   // "tsdb" partition, or TS_STORE_SIM_FILE; registers the "ts" command
+#ifdef SIMULATOR
+bool ts_store_open_file(const char* path, size_t size);
+void ts_store_close();   // flushes first
+#endif
+bool ts_store_append(uint8_t series, uint32_t t, int32_t value);
+bool ts_store_flush();   // program the partial page too
+void ts_store_poll();    // from the appending task: runs a queued "ts" command
+// Visits the samples of `series` with from_s <= t <= to_s, oldest first
+uint32_t ts_store_scan(uint8_t series, uint32_t from_s, uint32_t to_s, ts_store_visit_fn fn, void* ctx);
+void ts_store_get_stats(TsStoreStats& out);
+void ts_store_format();
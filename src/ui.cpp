@@ -1,13 +1,25 @@
 #include "ui.h"
 #include "config.h"
 #include "weather_icons.h"
+#include "ui_fonts.h"
+#include "icon_cache.h"
+#include "num_fmt.h"
+#include "perf_hud.h"
+#include "redraw_stats.h"
+#include "therm_card.h"
+#include "forecast_strip.h"
+#include "input_latency.h"
+#include "ui_layout.h"
 #include <lvgl.h>
+#include <string.h>
+#include <time.h>
 
 // Accent colors (same in both themes)
 #define COL_WARM      lv_color_hex(0xF97316)
 #define COL_COLD      lv_color_hex(0x3B82F6)
 #define COL_GREEN     lv_color_hex(0x22C55E)
 #define COL_RED       lv_color_hex(0xEF4444)
+#define COL_ICON      lv_color_hex(0xFBBF24)
 
 // Theme-dependent colors
 static bool dark_mode = true;
@@ -27,44 +39,28 @@ static lv_obj_t* lbl_wifi_status = nullptr;
 static lv_obj_t* lbl_title       = nullptr;
 static lv_obj_t* lbl_updated     = nullptr;
 
-// Left panel - indoor
-static lv_obj_t* lbl_indoor_title = nullptr;
-static lv_obj_t* bar_indoor       = nullptr;
-static lv_obj_t* lbl_indoor_temp  = nullptr;
-
-// Left panel - outdoor
-static lv_obj_t* lbl_outdoor_title = nullptr;
-static lv_obj_t* bar_outdoor       = nullptr;
-static lv_obj_t* lbl_outdoor_temp  = nullptr;
-
-// Left panel - sauna
-static lv_obj_t* lbl_sauna_title = nullptr;
-static lv_obj_t* bar_sauna       = nullptr;
-static lv_obj_t* lbl_sauna_temp  = nullptr;
+// Left panel - thermometer cards (one object each, see therm_card.cpp)
+static lv_obj_t* card_indoor  = nullptr;
+static lv_obj_t* card_outdoor = nullptr;
+static lv_obj_t* card_sauna   = nullptr;
 
 // Right panel - current weather
-static lv_obj_t* lbl_weather_icon  = nullptr;
+static lv_obj_t* img_weather_icon  = nullptr;  // cached icon image (icon_cache.cpp)
 static lv_obj_t* lbl_weather_cond  = nullptr;
 static lv_obj_t* lbl_weather_temp  = nullptr;
 static lv_obj_t* lbl_weather_wind  = nullptr;
 static lv_obj_t* lbl_weather_humid = nullptr;
 
-// Right panel - forecast
-static lv_obj_t* forecast_cards[3]      = {};
-static lv_obj_t* lbl_fc_day[3]          = {};
-static lv_obj_t* lbl_fc_icon[3]         = {};
-static lv_obj_t* lbl_fc_cond[3]         = {};
-static lv_obj_t* lbl_fc_high[3]         = {};
-static lv_obj_t* lbl_fc_low[3]          = {};
+// Right panel - forecast strip (one object for all days, see forecast_strip.cpp)
+static lv_obj_t* fc_strip = nullptr;
 
 // Containers (need refs for theme switching)
 static lv_obj_t* obj_status_bar   = nullptr;
 static lv_obj_t* obj_left_panel   = nullptr;
 static lv_obj_t* obj_right_panel  = nullptr;
-static lv_obj_t* obj_indoor_card  = nullptr;
-static lv_obj_t* obj_outdoor_card = nullptr;
-static lv_obj_t* obj_sauna_card   = nullptr;
 static lv_obj_t* obj_current_card = nullptr;
+static lv_obj_t* obj_weather_row  = nullptr;
+static lv_obj_t* obj_details_row  = nullptr;
 static lv_obj_t* lbl_fc_title     = nullptr;
 
 // Unit toggle
@@ -73,6 +69,15 @@ static lv_obj_t* lbl_unit_toggle  = nullptr;
 static bool use_fahrenheit = false;
 static HAWeatherData last_data = {};
 
+// Temperature text in both units ([use_fahrenheit]), formatted once per
+// snapshot so the unit toggle only swaps the text of these widgets
+static struct {
+    char indoor[2][12];
+    char outdoor[2][12];
+    char sauna[2][12];
+    char weather[2][12];
+} unit_text;
+
 // Theme toggle
 static lv_obj_t* btn_theme_toggle = nullptr;
 static lv_obj_t* lbl_theme_toggle = nullptr;
@@ -102,14 +107,114 @@ static void style_transparent(lv_obj_t* obj) {
     lv_obj_set_scrollbar_mode(obj, LV_SCROLLBAR_MODE_OFF);
 }
 
+#if UI_STATIC_LAYOUT
+// ----- Helper: fixed position/size from ui_layout.h -----
+static void place(lv_obj_t* obj, const UiRect& r) {
+    lv_obj_set_pos(obj, r.x, r.y);
+    lv_obj_set_size(obj, r.w, r.h);
+}
+
+// Labels clip instead of resizing to their text, so set_text never relayouts
+static void place_label(lv_obj_t* obj, const UiRect& r, lv_text_align_t align) {
+    place(obj, r);
+    lv_label_set_long_mode(obj, LV_LABEL_LONG_CLIP);
+    lv_obj_set_style_text_align(obj, align, 0);
+}
+
+// Images tile when the object is larger than the source, so the object takes
+// the image's own size (the same for every icon of a font), centered in `r`
+static void place_img(lv_obj_t* obj, const UiRect& r) {
+    lv_img_header_t header;
+    lv_coord_t w = r.w, h = r.h;
+    if (lv_img_decoder_get_info(lv_img_get_src(obj), &header) == LV_RES_OK && header.w > 1) {
+        w = header.w;
+        h = header.h;
+    }
+    lv_obj_set_pos(obj, r.x + (r.w - w) / 2, r.y + (r.h - h) / 2);
+    lv_obj_set_size(obj, w, h);
+}
+
+static void apply_static_layout() {
+    using namespace ui_layout;
+
+    place_label(lbl_wifi_icon,   wifi_icon,   LV_TEXT_ALIGN_LEFT);
+    place_label(lbl_wifi_status, wifi_status, LV_TEXT_ALIGN_LEFT);
+    place_label(lbl_title,       title,       LV_TEXT_ALIGN_CENTER);
+    place(btn_unit_toggle,  unit_toggle);
+    place(btn_theme_toggle, theme_toggle);
+    place_label(lbl_unit_toggle,  unit_label,  LV_TEXT_ALIGN_CENTER);
+    place_label(lbl_theme_toggle, theme_label, LV_TEXT_ALIGN_CENTER);
+    place_label(lbl_updated,     updated,     LV_TEXT_ALIGN_RIGHT);
+
+    place(card_indoor,  therm_card(0));
+    place(card_outdoor, therm_card(1));
+    place(card_sauna,   therm_card(2));
+
+    place(obj_current_card, current_card);
+    place(obj_weather_row,  weather_row);
+    place_img(img_weather_icon,    weather_icon);
+    place_label(lbl_weather_cond,  weather_cond,  LV_TEXT_ALIGN_LEFT);
+    place_label(lbl_weather_temp,  weather_temp,  LV_TEXT_ALIGN_RIGHT);
+    place(obj_details_row,  details_row);
+    place_label(lbl_weather_wind,  weather_wind,  LV_TEXT_ALIGN_RIGHT);
+    place_label(lbl_weather_humid, weather_humid, LV_TEXT_ALIGN_LEFT);
+
+    place_label(lbl_fc_title, forecast_title, LV_TEXT_ALIGN_LEFT);
+    place(fc_strip, forecast);
+}
+#endif
+
 // ----- Helper: C to F conversion -----
-static float to_display_temp(float celsius) {
-    if (use_fahrenheit) return celsius * 9.0f / 5.0f + 32.0f;
+static float to_display_temp(float celsius, bool fahrenheit) {
+    if (fahrenheit) return celsius * 9.0f / 5.0f + 32.0f;
     return celsius;
 }
 
-static const char* temp_unit() {
-    return use_fahrenheit ? "F" : "C";
+static void forecast_temp_fmt(float celsius, bool fahrenheit, char* buf, size_t len) {
+    num_fmt_value(buf, len, nullptr, to_display_temp(celsius, fahrenheit), 0, NUM_FMT_DEG);
+}
+
+// Both unit variants of every temperature in the snapshot
+static void format_unit_text(const HAWeatherData& data) {
+    for (int f = 0; f < 2; f++) {
+        const char* u = f ? NUM_FMT_DEG "F" : NUM_FMT_DEG "C";
+        num_fmt_value(unit_text.indoor[f], sizeof(unit_text.indoor[f]), nullptr,
+                      to_display_temp(data.indoor_temp.value, f), 1, u);
+        num_fmt_value(unit_text.outdoor[f], sizeof(unit_text.outdoor[f]), nullptr,
+                      to_display_temp(data.outdoor_temp.value, f), 1, u);
+        num_fmt_value(unit_text.sauna[f], sizeof(unit_text.sauna[f]), nullptr,
+                      to_display_temp(data.sauna_temp.value, f), 1, u);
+        num_fmt_value(unit_text.weather[f], sizeof(unit_text.weather[f]), nullptr,
+                      to_display_temp(data.current.temperature, f), 0, u);
+    }
+}
+
+// Put the current unit's text on the temperature widgets; nothing else changes
+static void apply_unit_text() {
+    const HAWeatherData& d = last_data;
+    if (d.indoor_temp.valid)  therm_card_set_text(card_indoor, unit_text.indoor[use_fahrenheit]);
+    if (d.outdoor_temp.valid) therm_card_set_text(card_outdoor, unit_text.outdoor[use_fahrenheit]);
+    if (d.sauna_temp.valid)   therm_card_set_text(card_sauna, unit_text.sauna[use_fahrenheit]);
+    if (d.current.valid)      lv_label_set_text(lbl_weather_temp, unit_text.weather[use_fahrenheit]);
+    forecast_strip_set_unit(fc_strip, use_fahrenheit);
+}
+
+// ----- Helper: current weather icon from the icon cache -----
+// Falls back to drawing the glyph as an image symbol if it is not cached
+static void set_weather_icon(const char* icon) {
+    const lv_img_dsc_t* img = icon_cache_get(icon, UI_FONT_WEATHER_40, COL_ICON);
+    if (img) {
+        if (lv_img_get_src(img_weather_icon) != img) lv_img_set_src(img_weather_icon, img);
+    } else {
+        lv_img_set_src(img_weather_icon, icon);
+    }
+}
+
+// ----- Helper: 24 h trend on the cards (needs the SNTP clock) -----
+static void record_history(TempSensor sensor, lv_obj_t* card, float celsius) {
+    time_t now = time(nullptr);
+    if (now < 1600000000) return;   // clock not set yet
+    if (temp_history_put(sensor, (uint32_t)now, celsius)) therm_card_history_changed(card);
 }
 
 // Forward declarations
@@ -121,7 +226,7 @@ static void unit_toggle_cb(lv_event_t* e) {
     use_fahrenheit = !use_fahrenheit;
     lv_label_set_text(lbl_unit_toggle, use_fahrenheit ? "\xC2\xB0" "F" : "\xC2\xB0" "C");
     if (last_data.has_data) {
-        ui_update(last_data);
+        apply_unit_text();
     }
 }
 
@@ -173,48 +278,51 @@ static void apply_theme() {
     lv_obj_set_style_bg_color(obj_right_panel, bg, 0);
 
     // Cards
-    lv_obj_t* cards[] = {obj_indoor_card, obj_outdoor_card, obj_sauna_card, obj_current_card};
+    lv_obj_t* cards[] = {card_indoor, card_outdoor, card_sauna, obj_current_card};
     for (auto c : cards) {
         lv_obj_set_style_bg_color(c, card, 0);
     }
-    for (int i = 0; i < 3; i++) {
-        lv_obj_set_style_bg_color(forecast_cards[i], card, 0);
+    lv_obj_t* therm_cards[] = {card_indoor, card_outdoor, card_sauna};
+    for (auto c : therm_cards) {
+        therm_card_set_colors(c, dim, text, trak);
     }
+    forecast_strip_set_colors(fc_strip, card, text, dim);
 
     // Titles (dim text)
-    lv_obj_t* dim_labels[] = {lbl_indoor_title, lbl_outdoor_title, lbl_sauna_title,
-                               lbl_weather_wind, lbl_weather_humid, lbl_fc_title};
+    lv_obj_t* dim_labels[] = {lbl_weather_wind, lbl_weather_humid, lbl_fc_title};
     for (auto l : dim_labels) {
         lv_obj_set_style_text_color(l, dim, 0);
     }
-    for (int i = 0; i < 3; i++) {
-        lv_obj_set_style_text_color(lbl_fc_cond[i], dim, 0);
-    }
 
     // Main text
-    lv_obj_t* text_labels[] = {lbl_indoor_temp, lbl_outdoor_temp, lbl_sauna_temp,
-                                lbl_weather_cond};
+    lv_obj_t* text_labels[] = {lbl_weather_cond};
     for (auto l : text_labels) {
         lv_obj_set_style_text_color(l, text, 0);
     }
-    for (int i = 0; i < 3; i++) {
-        lv_obj_set_style_text_color(lbl_fc_day[i], text, 0);
-    }
-
-    // Bar track backgrounds
-    lv_obj_t* bars[] = {bar_indoor, bar_outdoor, bar_sauna};
-    for (auto b : bars) {
-        lv_obj_set_style_bg_color(b, trak, 0);
-    }
 
     // Loading overlay
     lv_obj_set_style_bg_color(loading_overlay, bg, 0);
     lv_obj_set_style_text_color(loading_label, text, 0);
-    lv_obj_set_style_arc_color(loading_spinner, dim, 0);
+    if (loading_spinner) lv_obj_set_style_arc_color(loading_spinner, dim, 0);
+}
+
+// ----- Loading spinner -----
+// lv_spinner animates even while hidden, which keeps the main loop awake;
+// it only exists while the loading overlay is shown.
+static void create_loading_spinner() {
+    loading_spinner = lv_spinner_create(loading_overlay, 1000, 60);
+    lv_obj_set_size(loading_spinner, 60, 60);
+    lv_obj_center(loading_spinner);
+    lv_obj_set_style_arc_color(loading_spinner, col_text_dim(), 0);
+    lv_obj_set_style_arc_color(loading_spinner, COL_GREEN, LV_PART_INDICATOR);
 }
 
 // ----- Build the UI -----
 void ui_create() {
+    // Rasterize the weather icons once instead of blending glyphs per redraw
+    icon_cache_prewarm(UI_FONT_WEATHER_40, COL_ICON);
+    icon_cache_prewarm(UI_FONT_WEATHER_24, COL_ICON);
+
     lv_obj_t* scr = lv_scr_act();
     lv_obj_set_style_bg_color(scr, col_bg(), 0);
     lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
@@ -229,27 +337,30 @@ void ui_create() {
     lv_obj_set_style_border_width(obj_status_bar, 0, 0);
     lv_obj_set_style_pad_hor(obj_status_bar, 10, 0);
     lv_obj_set_style_pad_ver(obj_status_bar, 0, 0);
+#if !UI_STATIC_LAYOUT
     lv_obj_set_flex_flow(obj_status_bar, LV_FLEX_FLOW_ROW);
     lv_obj_set_flex_align(obj_status_bar, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+#endif
     lv_obj_clear_flag(obj_status_bar, LV_OBJ_FLAG_SCROLLABLE);
 
     lbl_wifi_icon = lv_label_create(obj_status_bar);
     lv_label_set_text(lbl_wifi_icon, LV_SYMBOL_WIFI);
     lv_obj_set_style_text_color(lbl_wifi_icon, COL_GREEN, 0);
-    lv_obj_set_style_text_font(lbl_wifi_icon, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(lbl_wifi_icon, UI_FONT_16, 0);
 
     lbl_wifi_status = lv_label_create(obj_status_bar);
     lv_label_set_text(lbl_wifi_status, "Connecting...");
     lv_obj_set_style_text_color(lbl_wifi_status, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_wifi_status, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_font(lbl_wifi_status, UI_FONT_12, 0);
     lv_obj_set_style_pad_left(lbl_wifi_status, 6, 0);
 
     lbl_title = lv_label_create(obj_status_bar);
     lv_label_set_text(lbl_title, "Home Weather");
     lv_obj_set_style_text_color(lbl_title, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_title, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(lbl_title, UI_FONT_16, 0);
     lv_obj_set_flex_grow(lbl_title, 1);
     lv_obj_set_style_text_align(lbl_title, LV_TEXT_ALIGN_CENTER, 0);
+    perf_hud_attach_toggle(lbl_title);   // long-press: performance HUD
 
     // °C / °F toggle button
     btn_unit_toggle = lv_btn_create(obj_status_bar);
@@ -262,12 +373,15 @@ void ui_create() {
     lv_obj_set_style_pad_all(btn_unit_toggle, 0, 0);
     lv_obj_set_style_shadow_width(btn_unit_toggle, 0, 0);
     lv_obj_add_event_cb(btn_unit_toggle, unit_toggle_cb, LV_EVENT_CLICKED, nullptr);
+    input_latency_track(btn_unit_toggle);
 
     lbl_unit_toggle = lv_label_create(btn_unit_toggle);
     lv_label_set_text(lbl_unit_toggle, "\xC2\xB0" "C");
     lv_obj_set_style_text_color(lbl_unit_toggle, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_unit_toggle, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_font(lbl_unit_toggle, UI_FONT_14, 0);
+#if !UI_STATIC_LAYOUT
     lv_obj_center(lbl_unit_toggle);
+#endif
 
     // Light/Dark theme toggle button
     btn_theme_toggle = lv_btn_create(obj_status_bar);
@@ -280,17 +394,20 @@ void ui_create() {
     lv_obj_set_style_pad_all(btn_theme_toggle, 0, 0);
     lv_obj_set_style_shadow_width(btn_theme_toggle, 0, 0);
     lv_obj_add_event_cb(btn_theme_toggle, theme_toggle_cb, LV_EVENT_CLICKED, nullptr);
+    input_latency_track(btn_theme_toggle);
 
     lbl_theme_toggle = lv_label_create(btn_theme_toggle);
     lv_label_set_text(lbl_theme_toggle, LV_SYMBOL_EYE_CLOSE);
     lv_obj_set_style_text_color(lbl_theme_toggle, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_theme_toggle, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_font(lbl_theme_toggle, UI_FONT_14, 0);
+#if !UI_STATIC_LAYOUT
     lv_obj_center(lbl_theme_toggle);
+#endif
 
     lbl_updated = lv_label_create(obj_status_bar);
     lv_label_set_text(lbl_updated, "Updated: --:--");
     lv_obj_set_style_text_color(lbl_updated, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_updated, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_font(lbl_updated, UI_FONT_12, 0);
     lv_obj_set_style_pad_left(lbl_updated, 8, 0);
 
     // ===== MAIN CONTENT AREA =====
@@ -307,99 +424,33 @@ void ui_create() {
     lv_obj_set_style_border_width(obj_left_panel, 0, 0);
     lv_obj_set_style_pad_all(obj_left_panel, 6, 0);
     lv_obj_set_style_pad_row(obj_left_panel, 4, 0);
+#if !UI_STATIC_LAYOUT
     lv_obj_set_flex_flow(obj_left_panel, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(obj_left_panel, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+#endif
     lv_obj_clear_flag(obj_left_panel, LV_OBJ_FLAG_SCROLLABLE);
 
-    // --- Indoor card ---
-    obj_indoor_card = lv_obj_create(obj_left_panel);
-    lv_obj_set_size(obj_indoor_card, lv_pct(100), LV_SIZE_CONTENT);
-    style_card(obj_indoor_card);
-    lv_obj_set_style_pad_all(obj_indoor_card, 8, 0);
-    lv_obj_set_flex_flow(obj_indoor_card, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(obj_indoor_card, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_clear_flag(obj_indoor_card, LV_OBJ_FLAG_SCROLLABLE);
-
-    lbl_indoor_title = lv_label_create(obj_indoor_card);
-    lv_label_set_text(lbl_indoor_title, "INDOOR");
-    lv_obj_set_style_text_color(lbl_indoor_title, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_indoor_title, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_pad_bottom(lbl_indoor_title, 2, 0);
-
-    bar_indoor = lv_bar_create(obj_indoor_card);
-    lv_obj_set_size(bar_indoor, 20, 40);
-    lv_bar_set_range(bar_indoor, -10, 40);
-    lv_bar_set_value(bar_indoor, 0, LV_ANIM_OFF);
-    lv_obj_set_style_bg_color(bar_indoor, col_bar_track(), 0);
-    lv_obj_set_style_bg_color(bar_indoor, COL_WARM, LV_PART_INDICATOR);
-    lv_obj_set_style_radius(bar_indoor, 10, 0);
-    lv_obj_set_style_radius(bar_indoor, 10, LV_PART_INDICATOR);
-
-    lbl_indoor_temp = lv_label_create(obj_indoor_card);
-    lv_label_set_text(lbl_indoor_temp, "--.- C");
-    lv_obj_set_style_text_color(lbl_indoor_temp, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_indoor_temp, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_pad_top(lbl_indoor_temp, 2, 0);
-
-    // --- Outdoor card ---
-    obj_outdoor_card = lv_obj_create(obj_left_panel);
-    lv_obj_set_size(obj_outdoor_card, lv_pct(100), LV_SIZE_CONTENT);
-    style_card(obj_outdoor_card);
-    lv_obj_set_style_pad_all(obj_outdoor_card, 8, 0);
-    lv_obj_set_flex_flow(obj_outdoor_card, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(obj_outdoor_card, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_clear_flag(obj_outdoor_card, LV_OBJ_FLAG_SCROLLABLE);
-
-    lbl_outdoor_title = lv_label_create(obj_outdoor_card);
-    lv_label_set_text(lbl_outdoor_title, "OUTDOOR");
-    lv_obj_set_style_text_color(lbl_outdoor_title, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_outdoor_title, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_pad_bottom(lbl_outdoor_title, 2, 0);
-
-    bar_outdoor = lv_bar_create(obj_outdoor_card);
-    lv_obj_set_size(bar_outdoor, 20, 40);
-    lv_bar_set_range(bar_outdoor, -20, 40);
-    lv_bar_set_value(bar_outdoor, 0, LV_ANIM_OFF);
-    lv_obj_set_style_bg_color(bar_outdoor, col_bar_track(), 0);
-    lv_obj_set_style_bg_color(bar_outdoor, COL_COLD, LV_PART_INDICATOR);
-    lv_obj_set_style_radius(bar_outdoor, 10, 0);
-    lv_obj_set_style_radius(bar_outdoor, 10, LV_PART_INDICATOR);
-
-    lbl_outdoor_temp = lv_label_create(obj_outdoor_card);
-    lv_label_set_text(lbl_outdoor_temp, "--.- C");
-    lv_obj_set_style_text_color(lbl_outdoor_temp, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_outdoor_temp, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_pad_top(lbl_outdoor_temp, 2, 0);
-
-    // --- Sauna card ---
-    obj_sauna_card = lv_obj_create(obj_left_panel);
-    lv_obj_set_size(obj_sauna_card, lv_pct(100), LV_SIZE_CONTENT);
-    style_card(obj_sauna_card);
-    lv_obj_set_style_pad_all(obj_sauna_card, 8, 0);
-    lv_obj_set_flex_flow(obj_sauna_card, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(obj_sauna_card, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_clear_flag(obj_sauna_card, LV_OBJ_FLAG_SCROLLABLE);
-
-    lbl_sauna_title = lv_label_create(obj_sauna_card);
-    lv_label_set_text(lbl_sauna_title, "SAUNA");
-    lv_obj_set_style_text_color(lbl_sauna_title, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_sauna_title, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_pad_bottom(lbl_sauna_title, 2, 0);
-
-    bar_sauna = lv_bar_create(obj_sauna_card);
-    lv_obj_set_size(bar_sauna, 20, 40);
-    lv_bar_set_range(bar_sauna, 0, 110);
-    lv_bar_set_value(bar_sauna, 0, LV_ANIM_OFF);
-    lv_obj_set_style_bg_color(bar_sauna, col_bar_track(), 0);
-    lv_obj_set_style_bg_color(bar_sauna, COL_RED, LV_PART_INDICATOR);
-    lv_obj_set_style_radius(bar_sauna, 10, 0);
-    lv_obj_set_style_radius(bar_sauna, 10, LV_PART_INDICATOR);
-
-    lbl_sauna_temp = lv_label_create(obj_sauna_card);
-    lv_label_set_text(lbl_sauna_temp, "--.- C");
-    lv_obj_set_style_text_color(lbl_sauna_temp, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_sauna_temp, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_pad_top(lbl_sauna_temp, 2, 0);
+    // --- Thermometer cards ---
+    card_indoor = therm_card_create(obj_left_panel, "INDOOR");
+    style_card(card_indoor);
+    therm_card_set_range(card_indoor, -10, 40);
+    therm_card_set_value(card_indoor, 0, COL_WARM, false);
+    therm_card_set_text(card_indoor, "--.- C");
+    therm_card_set_history(card_indoor, temp_history_get(TEMP_INDOOR));
+
+    card_outdoor = therm_card_create(obj_left_panel, "OUTDOOR");
+    style_card(card_outdoor);
+    therm_card_set_range(card_outdoor, -20, 40);
+    therm_card_set_value(card_outdoor, 0, COL_COLD, false);
+    therm_card_set_text(card_outdoor, "--.- C");
+    therm_card_set_history(card_outdoor, temp_history_get(TEMP_OUTDOOR));
+
+    card_sauna = therm_card_create(obj_left_panel, "SAUNA");
+    style_card(card_sauna);
+    therm_card_set_range(card_sauna, 0, 110);
+    therm_card_set_value(card_sauna, 0, COL_RED, false);
+    therm_card_set_text(card_sauna, "--.- C");
+    therm_card_set_history(card_sauna, temp_history_get(TEMP_SAUNA));
 
     // ===== RIGHT PANEL (580px) =====
     obj_right_panel = lv_obj_create(scr);
@@ -410,7 +461,9 @@ void ui_create() {
     lv_obj_set_style_radius(obj_right_panel, 0, 0);
     lv_obj_set_style_border_width(obj_right_panel, 0, 0);
     lv_obj_set_style_pad_all(obj_right_panel, 8, 0);
+#if !UI_STATIC_LAYOUT
     lv_obj_set_flex_flow(obj_right_panel, LV_FLEX_FLOW_COLUMN);
+#endif
     lv_obj_clear_flag(obj_right_panel, LV_OBJ_FLAG_SCROLLABLE);
 
     // --- Current weather card ---
@@ -421,199 +474,167 @@ void ui_create() {
     lv_obj_clear_flag(obj_current_card, LV_OBJ_FLAG_SCROLLABLE);
 
     // Top row: icon + condition + temperature
-    lv_obj_t* weather_row = lv_obj_create(obj_current_card);
-    lv_obj_set_size(weather_row, lv_pct(100), LV_SIZE_CONTENT);
-    style_transparent(weather_row);
-    lv_obj_set_flex_flow(weather_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(weather_row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-
-    lbl_weather_icon = lv_label_create(weather_row);
-    lv_label_set_text(lbl_weather_icon, ICON_WEATHER_SUNNY);
-    lv_obj_set_style_text_color(lbl_weather_icon, lv_color_hex(0xFBBF24), 0);
-    lv_obj_set_style_text_font(lbl_weather_icon, &weather_font_40, 0);
-
-    lbl_weather_cond = lv_label_create(weather_row);
+    obj_weather_row = lv_obj_create(obj_current_card);
+    lv_obj_set_size(obj_weather_row, lv_pct(100), LV_SIZE_CONTENT);
+    style_transparent(obj_weather_row);
+#if !UI_STATIC_LAYOUT
+    lv_obj_set_flex_flow(obj_weather_row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(obj_weather_row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+#endif
+
+    img_weather_icon = lv_img_create(obj_weather_row);
+    lv_obj_set_style_text_color(img_weather_icon, COL_ICON, 0);        // symbol fallback
+    lv_obj_set_style_text_font(img_weather_icon, UI_FONT_WEATHER_40, 0);
+    set_weather_icon(ICON_WEATHER_SUNNY);
+
+    lbl_weather_cond = lv_label_create(obj_weather_row);
     lv_label_set_text(lbl_weather_cond, "Loading...");
     lv_obj_set_style_text_color(lbl_weather_cond, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_weather_cond, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_font(lbl_weather_cond, UI_FONT_20, 0);
     lv_obj_set_style_pad_left(lbl_weather_cond, 12, 0);
 
-    lbl_weather_temp = lv_label_create(weather_row);
+    lbl_weather_temp = lv_label_create(obj_weather_row);
     lv_label_set_text(lbl_weather_temp, "-- C");
     lv_obj_set_style_text_color(lbl_weather_temp, col_text(), 0);
-    lv_obj_set_style_text_font(lbl_weather_temp, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(lbl_weather_temp, UI_FONT_40, 0);
     lv_obj_set_flex_grow(lbl_weather_temp, 1);
     lv_obj_set_style_text_align(lbl_weather_temp, LV_TEXT_ALIGN_RIGHT, 0);
 
     // Details row: wind + humidity
-    lv_obj_t* details_row = lv_obj_create(obj_current_card);
-    lv_obj_set_size(details_row, lv_pct(100), LV_SIZE_CONTENT);
-    style_transparent(details_row);
-    lv_obj_set_style_pad_top(details_row, 8, 0);
-    lv_obj_set_flex_flow(details_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(details_row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-
-    lbl_weather_wind = lv_label_create(details_row);
+    obj_details_row = lv_obj_create(obj_current_card);
+    lv_obj_set_size(obj_details_row, lv_pct(100), LV_SIZE_CONTENT);
+    style_transparent(obj_details_row);
+    lv_obj_set_style_pad_top(obj_details_row, 8, 0);
+#if !UI_STATIC_LAYOUT
+    lv_obj_set_flex_flow(obj_details_row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(obj_details_row, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+#endif
+
+    lbl_weather_wind = lv_label_create(obj_details_row);
     lv_label_set_text(lbl_weather_wind, "Wind: -- km/h");
     lv_obj_set_style_text_color(lbl_weather_wind, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_weather_wind, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(lbl_weather_wind, UI_FONT_16, 0);
 
-    lv_obj_t* detail_spacer = lv_obj_create(details_row);
+#if !UI_STATIC_LAYOUT
+    lv_obj_t* detail_spacer = lv_obj_create(obj_details_row);
     lv_obj_set_size(detail_spacer, 30, 1);
     style_transparent(detail_spacer);
+#endif
 
-    lbl_weather_humid = lv_label_create(details_row);
+    lbl_weather_humid = lv_label_create(obj_details_row);
     lv_label_set_text(lbl_weather_humid, "Humidity: --%");
     lv_obj_set_style_text_color(lbl_weather_humid, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_weather_humid, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(lbl_weather_humid, UI_FONT_16, 0);
 
+#if !UI_STATIC_LAYOUT
     // Spacer between current and forecast
     lv_obj_t* mid_spacer = lv_obj_create(obj_right_panel);
     lv_obj_set_size(mid_spacer, 1, 8);
     style_transparent(mid_spacer);
+#endif
 
     // --- Forecast section ---
     lbl_fc_title = lv_label_create(obj_right_panel);
-    lv_label_set_text(lbl_fc_title, "3-DAY FORECAST");
+    lv_label_set_text(lbl_fc_title, "FORECAST");
     lv_obj_set_style_text_color(lbl_fc_title, col_text_dim(), 0);
-    lv_obj_set_style_text_font(lbl_fc_title, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_font(lbl_fc_title, UI_FONT_14, 0);
     lv_obj_set_style_pad_bottom(lbl_fc_title, 6, 0);
 
-    // Forecast row
-    lv_obj_t* fc_row = lv_obj_create(obj_right_panel);
-    lv_obj_set_size(fc_row, lv_pct(100), LV_SIZE_CONTENT);
-    style_transparent(fc_row);
-    lv_obj_set_flex_flow(fc_row, LV_FLEX_FLOW_ROW);
-    lv_obj_set_flex_align(fc_row, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START);
-
-    for (int i = 0; i < 3; i++) {
-        forecast_cards[i] = lv_obj_create(fc_row);
-        lv_obj_set_size(forecast_cards[i], 160, LV_SIZE_CONTENT);
-        style_card(forecast_cards[i]);
-        lv_obj_set_style_pad_all(forecast_cards[i], 12, 0);
-        lv_obj_set_flex_flow(forecast_cards[i], LV_FLEX_FLOW_COLUMN);
-        lv_obj_set_flex_align(forecast_cards[i], LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-        lv_obj_clear_flag(forecast_cards[i], LV_OBJ_FLAG_SCROLLABLE);
-
-        lbl_fc_day[i] = lv_label_create(forecast_cards[i]);
-        lv_label_set_text(lbl_fc_day[i], "---");
-        lv_obj_set_style_text_color(lbl_fc_day[i], col_text(), 0);
-        lv_obj_set_style_text_font(lbl_fc_day[i], &lv_font_montserrat_16, 0);
-        lv_obj_set_style_pad_bottom(lbl_fc_day[i], 4, 0);
-
-        lbl_fc_icon[i] = lv_label_create(forecast_cards[i]);
-        lv_label_set_text(lbl_fc_icon[i], ICON_WEATHER_CLOUDY);
-        lv_obj_set_style_text_color(lbl_fc_icon[i], lv_color_hex(0xFBBF24), 0);
-        lv_obj_set_style_text_font(lbl_fc_icon[i], &weather_font_24, 0);
-        lv_obj_set_style_pad_bottom(lbl_fc_icon[i], 4, 0);
-
-        lbl_fc_cond[i] = lv_label_create(forecast_cards[i]);
-        lv_label_set_text(lbl_fc_cond[i], "--");
-        lv_obj_set_style_text_color(lbl_fc_cond[i], col_text_dim(), 0);
-        lv_obj_set_style_text_font(lbl_fc_cond[i], &lv_font_montserrat_14, 0);
-        lv_obj_set_style_pad_bottom(lbl_fc_cond[i], 2, 0);
-
-        lbl_fc_high[i] = lv_label_create(forecast_cards[i]);
-        lv_label_set_text(lbl_fc_high[i], "H: --");
-        lv_obj_set_style_text_color(lbl_fc_high[i], COL_WARM, 0);
-        lv_obj_set_style_text_font(lbl_fc_high[i], &lv_font_montserrat_14, 0);
-
-        lbl_fc_low[i] = lv_label_create(forecast_cards[i]);
-        lv_label_set_text(lbl_fc_low[i], "L: --");
-        lv_obj_set_style_text_color(lbl_fc_low[i], COL_COLD, 0);
-        lv_obj_set_style_text_font(lbl_fc_low[i], &lv_font_montserrat_14, 0);
-    }
+    fc_strip = forecast_strip_create(obj_right_panel, forecast_temp_fmt);
+    style_transparent(fc_strip);
 
     // ===== LOADING OVERLAY =====
     loading_overlay = lv_obj_create(scr);
     lv_obj_set_size(loading_overlay, SCREEN_WIDTH, SCREEN_HEIGHT);
     lv_obj_set_pos(loading_overlay, 0, 0);
     lv_obj_set_style_bg_color(loading_overlay, col_bg(), 0);
-    lv_obj_set_style_bg_opa(loading_overlay, LV_OPA_80, 0);
+    lv_obj_set_style_bg_opa(loading_overlay, UI_LOADING_OPA, 0);
     lv_obj_set_style_radius(loading_overlay, 0, 0);
     lv_obj_set_style_border_width(loading_overlay, 0, 0);
     lv_obj_clear_flag(loading_overlay, LV_OBJ_FLAG_SCROLLABLE);
 
-    loading_spinner = lv_spinner_create(loading_overlay, 1000, 60);
-    lv_obj_set_size(loading_spinner, 60, 60);
-    lv_obj_center(loading_spinner);
-    lv_obj_set_style_arc_color(loading_spinner, col_text_dim(), 0);
-    lv_obj_set_style_arc_color(loading_spinner, COL_GREEN, LV_PART_INDICATOR);
+    create_loading_spinner();
 
     loading_label = lv_label_create(loading_overlay);
     lv_label_set_text(loading_label, "Connecting...");
     lv_obj_set_style_text_color(loading_label, col_text(), 0);
-    lv_obj_set_style_text_font(loading_label, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_font(loading_label, UI_FONT_16, 0);
     lv_obj_align_to(loading_label, loading_spinner, LV_ALIGN_OUT_BOTTOM_MID, 0, 16);
+
+#if UI_STATIC_LAYOUT
+    apply_static_layout();
+#endif
+
+    // Redraw attribution (no-op unless REDRAW_STATS is enabled)
+    redraw_stats_track(obj_status_bar,   "status_bar");
+    redraw_stats_track(lbl_wifi_status,  "wifi_status");
+    redraw_stats_track(lbl_updated,      "updated");
+    redraw_stats_track(btn_unit_toggle,  "unit_toggle");
+    redraw_stats_track(btn_theme_toggle, "theme_toggle");
+    redraw_stats_track(card_indoor,      "indoor_card");
+    redraw_stats_track(card_outdoor,     "outdoor_card");
+    redraw_stats_track(card_sauna,       "sauna_card");
+    redraw_stats_track(obj_current_card, "current_card");
+    redraw_stats_track(img_weather_icon, "weather_icon");
+    redraw_stats_track(lbl_weather_temp, "weather_temp");
+    redraw_stats_track(fc_strip,         "forecast");
+    redraw_stats_track(loading_overlay,  "loading_overlay");
+    redraw_stats_track(loading_label,    "loading_label");
+}
+
+// ----- Thermometer card of one sensor from last_data / unit_text -----
+static void show_temperature(TempSensor sensor) {
+    const HATemperature* temps[TEMP_SENSOR_COUNT] = {&last_data.indoor_temp, &last_data.outdoor_temp,
+                                                     &last_data.sauna_temp};
+    lv_obj_t* cards[TEMP_SENSOR_COUNT] = {card_indoor, card_outdoor, card_sauna};
+    const char* text[TEMP_SENSOR_COUNT] = {unit_text.indoor[use_fahrenheit], unit_text.outdoor[use_fahrenheit],
+                                           unit_text.sauna[use_fahrenheit]};
+    const HATemperature& t = *temps[sensor];
+    if (!t.valid) return;
+
+    lv_color_t color = temp_color(t.value);
+    if (sensor == TEMP_SAUNA) {
+        if (t.value >= 60) color = COL_RED;
+        else if (t.value >= 30) color = COL_WARM;
+        else color = lv_color_hex(0x06B6D4);
+    }
+    therm_card_set_text(cards[sensor], text[sensor]);
+    therm_card_set_value(cards[sensor], t.value, color, true);
+    record_history(sensor, cards[sensor], t.value);
 }
 
 // ----- Update UI with new data -----
 void ui_update(const HAWeatherData& data) {
     last_data = data;
     char buf[64];
-    const char* u = temp_unit();
-
-    // Indoor temperature
-    if (data.indoor_temp.valid) {
-        snprintf(buf, sizeof(buf), "%.1f\xC2\xB0%s", to_display_temp(data.indoor_temp.value), u);
-        lv_label_set_text(lbl_indoor_temp, buf);
-        lv_bar_set_value(bar_indoor, (int)data.indoor_temp.value, LV_ANIM_ON);
-        lv_obj_set_style_bg_color(bar_indoor, temp_color(data.indoor_temp.value), LV_PART_INDICATOR);
-    }
+    format_unit_text(data);
 
-    // Outdoor temperature
-    if (data.outdoor_temp.valid) {
-        snprintf(buf, sizeof(buf), "%.1f\xC2\xB0%s", to_display_temp(data.outdoor_temp.value), u);
-        lv_label_set_text(lbl_outdoor_temp, buf);
-        lv_bar_set_value(bar_outdoor, (int)data.outdoor_temp.value, LV_ANIM_ON);
-        lv_obj_set_style_bg_color(bar_outdoor, temp_color(data.outdoor_temp.value), LV_PART_INDICATOR);
-    }
-
-    // Sauna temperature
-    if (data.sauna_temp.valid) {
-        snprintf(buf, sizeof(buf), "%.1f\xC2\xB0%s", to_display_temp(data.sauna_temp.value), u);
-        lv_label_set_text(lbl_sauna_temp, buf);
-        lv_bar_set_value(bar_sauna, (int)data.sauna_temp.value, LV_ANIM_ON);
-        lv_color_t sc;
-        if (data.sauna_temp.value >= 60) sc = COL_RED;
-        else if (data.sauna_temp.value >= 30) sc = COL_WARM;
-        else sc = lv_color_hex(0x06B6D4);
-        lv_obj_set_style_bg_color(bar_sauna, sc, LV_PART_INDICATOR);
-    }
+    // Thermometer cards
+    for (int t = 0; t < TEMP_SENSOR_COUNT; t++) show_temperature((TempSensor)t);
 
     // Current weather
     if (data.current.valid) {
         WeatherDisplay wd = weather_get_display(data.current.condition.c_str());
-        lv_label_set_text(lbl_weather_icon, wd.icon);
+        set_weather_icon(wd.icon);
         lv_label_set_text(lbl_weather_cond, wd.label);
 
-        snprintf(buf, sizeof(buf), "%.0f\xC2\xB0%s", to_display_temp(data.current.temperature), u);
-        lv_label_set_text(lbl_weather_temp, buf);
+        lv_label_set_text(lbl_weather_temp, unit_text.weather[use_fahrenheit]);
         lv_obj_set_style_text_color(lbl_weather_temp, temp_color(data.current.temperature), 0);
 
-        snprintf(buf, sizeof(buf), "Wind: %.0f km/h", data.current.wind_speed);
+        num_fmt_value(buf, sizeof(buf), "Wind: ", data.current.wind_speed, 0, " km/h");
         lv_label_set_text(lbl_weather_wind, buf);
 
-        snprintf(buf, sizeof(buf), "Humidity: %.0f%%", data.current.humidity);
+        num_fmt_value(buf, sizeof(buf), "Humidity: ", data.current.humidity, 0, "%");
         lv_label_set_text(lbl_weather_humid, buf);
     }
 
-    // Forecast
-    for (int i = 0; i < 3; i++) {
-        if (data.forecast[i].valid) {
-            lv_label_set_text(lbl_fc_day[i], data.forecast[i].day_name.c_str());
-
-            WeatherDisplay wd = weather_get_display(data.forecast[i].condition.c_str());
-            lv_label_set_text(lbl_fc_icon[i], wd.icon);
-            lv_label_set_text(lbl_fc_cond[i], wd.label);
-
-            snprintf(buf, sizeof(buf), "H: %.0f\xC2\xB0", to_display_temp(data.forecast[i].temp_high));
-            lv_label_set_text(lbl_fc_high[i], buf);
-
-            snprintf(buf, sizeof(buf), "L: %.0f\xC2\xB0", to_display_temp(data.forecast[i].temp_low));
-            lv_label_set_text(lbl_fc_low[i], buf);
-        }
+    // Forecast (the strip keeps a pointer into last_data, which outlives this call)
+    if (strcmp(HA_FORECAST_TYPE, "hourly") == 0) {
+        lv_label_set_text(lbl_fc_title, "HOURLY FORECAST");
+    } else {
+        lv_label_set_text_fmt(lbl_fc_title, "%d-DAY FORECAST", last_data.forecast_count);
     }
+    forecast_strip_set_data(fc_strip, last_data.forecast, last_data.forecast_count);
 
     // Updated timestamp
     if (data.last_updated.length() > 0) {
@@ -622,12 +643,32 @@ void ui_update(const HAWeatherData& data) {
     }
 }
 
+void ui_set_temperature(TempSensor sensor, float celsius) {
+    HATemperature* temps[TEMP_SENSOR_COUNT] = {&last_data.indoor_temp, &last_data.outdoor_temp,
+                                               &last_data.sauna_temp};
+    temps[sensor]->value = celsius;
+    temps[sensor]->valid = true;
+    format_unit_text(last_data);
+    show_temperature(sensor);
+}
+
+void ui_history_changed() {
+    therm_card_history_changed(card_indoor);
+    therm_card_history_changed(card_outdoor);
+    therm_card_history_changed(card_sauna);
+}
+
 void ui_show_loading(bool show) {
     if (loading_overlay) {
         if (show) {
+            if (!loading_spinner) create_loading_spinner();
             lv_obj_clear_flag(loading_overlay, LV_OBJ_FLAG_HIDDEN);
         } else {
             lv_obj_add_flag(loading_overlay, LV_OBJ_FLAG_HIDDEN);
+            if (loading_spinner) {
+                lv_obj_del(loading_spinner);
+                loading_spinner = nullptr;
+            }
         }
     }
 }
@@ -1,7 +1,10 @@
 #pragma once
 #include "ha_client.h"
+#include "temp_history.h"
 
 void ui_create();
 void ui_update(const HAWeatherData& data);
+void ui_set_temperature(TempSensor sensor, float celsius);   // one card, outside a full snapshot
+void ui_history_changed();   // redraw the card sparklines after a bulk history change
 void ui_show_loading(bool show);
 void ui_set_wifi_status(bool connected);
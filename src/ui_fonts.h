@@ -0,0 +1,49 @@
+#pragma once
+#include <lvgl.h>
+#include "config.h"
+#include "weather_icons.h"
+
+// Fonts used by the UI. With UI_SUBSET_FONTS, tools/gen_fonts.py generates
+// fonts holding only the glyphs the sources use (src/fonts/generated/) and
+// these macros point at them; otherwise they are the LVGL built-ins and the
+// checked-in weather icon fonts.
+#if UI_SUBSET_FONTS
+
+#if UI_SUBSET_FONTS_COMPRESS
+#define UI_FONT_SUBSET(name) ui_font_##name##_z
+#else
+#define UI_FONT_SUBSET(name) ui_font_##name
+#endif
+
+LV_FONT_DECLARE(UI_FONT_SUBSET(montserrat_12))
+LV_FONT_DECLARE(UI_FONT_SUBSET(montserrat_14))
+LV_FONT_DECLARE(UI_FONT_SUBSET(montserrat_16))
+LV_FONT_DECLARE(UI_FONT_SUBSET(montserrat_20))
+LV_FONT_DECLARE(UI_FONT_SUBSET(montserrat_40))
+#define UI_FONT_12 (&UI_FONT_SUBSET(montserrat_12))
+#define UI_FONT_14 (&UI_FONT_SUBSET(montserrat_14))
+#define UI_FONT_16 (&UI_FONT_SUBSET(montserrat_16))
+#define UI_FONT_20 (&UI_FONT_SUBSET(montserrat_20))
+#define UI_FONT_40 (&UI_FONT_SUBSET(montserrat_40))
+
+#else
+
+#define UI_FONT_12 (&lv_font_montserrat_12)
+#define UI_FONT_14 (&lv_font_montserrat_14)
+#define UI_FONT_16 (&lv_font_montserrat_16)
+#define UI_FONT_20 (&lv_font_montserrat_20)
+#define UI_FONT_40 (&lv_font_montserrat_40)
+
+#endif
+
+// Weather icons are only regenerated when the MDI font file is available
+// (the script defines UI_SUBSET_WEATHER_FONTS); else the checked-in fonts.
+#if UI_SUBSET_FONTS && defined(UI_SUBSET_WEATHER_FONTS)
+LV_FONT_DECLARE(UI_FONT_SUBSET(weather_24))
+LV_FONT_DECLARE(UI_FONT_SUBSET(weather_40))
+#define UI_FONT_WEATHER_24 (&UI_FONT_SUBSET(weather_24))
+#define UI_FONT_WEATHER_40 (&UI_FONT_SUBSET(weather_40))
+#else
+#define UI_FONT_WEATHER_24 (&weather_font_24)
+#define UI_FONT_WEATHER_40 (&weather_font_40)
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include <lvgl.h>
+#include "config.h"
+#include "therm_card.h"
+#include "forecast_strip.h"
+
+// Fixed widget rectangles used when UI_STATIC_LAYOUT is enabled. Positions are
+// relative to the parent's content area (inside the paddings ui_create() sets),
+// so nothing depends on text width and label updates never trigger a relayout.
+struct UiRect {
+    lv_coord_t x, y, w, h;
+};
+
+namespace ui_layout {
+
+// Paddings set in ui_create()
+constexpr lv_coord_t STATUS_PAD_HOR = 10;
+constexpr lv_coord_t LEFT_PAD       = 6;
+constexpr lv_coord_t LEFT_GAP       = 4;
+constexpr lv_coord_t RIGHT_PAD      = 8;
+constexpr lv_coord_t CURRENT_PAD    = 16;
+
+constexpr lv_coord_t CONTENT_H  = SCREEN_HEIGHT - STATUS_BAR_H;
+constexpr lv_coord_t STATUS_W   = SCREEN_WIDTH - 2 * STATUS_PAD_HOR;
+constexpr lv_coord_t LEFT_W     = LEFT_PANEL_W - 2 * LEFT_PAD;
+constexpr lv_coord_t RIGHT_W    = RIGHT_PANEL_W - 2 * RIGHT_PAD;
+constexpr lv_coord_t RIGHT_H    = CONTENT_H - 2 * RIGHT_PAD;
+constexpr lv_coord_t CURRENT_W  = RIGHT_W - 2 * CURRENT_PAD;
+
+constexpr lv_coord_t vcenter(lv_coord_t parent_h, lv_coord_t h) { return (parent_h - h) / 2; }
+
+// ----- Status bar: left group, centered title, right group -----
+constexpr UiRect wifi_icon    = {0, vcenter(STATUS_BAR_H, 18), 20, 18};
+constexpr UiRect wifi_status  = {wifi_icon.w, vcenter(STATUS_BAR_H, 16), 96, 16};
+constexpr UiRect updated      = {STATUS_W - 112, vcenter(STATUS_BAR_H, 16), 112, 16};
+constexpr UiRect theme_toggle = {updated.x - 8 - 40, vcenter(STATUS_BAR_H, 28), 40, 28};
+constexpr UiRect unit_toggle  = {theme_toggle.x - 6 - 44, vcenter(STATUS_BAR_H, 28), 44, 28};
+// Toggle labels fill their button (inside the 1px border)
+constexpr UiRect unit_label   = {0, vcenter(unit_toggle.h - 2, 16), unit_toggle.w - 2, 16};
+constexpr UiRect theme_label  = {0, vcenter(theme_toggle.h - 2, 16), theme_toggle.w - 2, 16};
+constexpr UiRect title        = {SCREEN_WIDTH / 2 - STATUS_PAD_HOR - 150, vcenter(STATUS_BAR_H, 18), 300, 18};
+
+// ----- Left panel: thermometer cards stacked from the top -----
+constexpr UiRect therm_card(int i) {
+    return {0, (lv_coord_t)(i * (THERM_CARD_H + LEFT_GAP)), LEFT_W, THERM_CARD_H};
+}
+
+// ----- Right panel: current weather card, forecast title, forecast strip -----
+constexpr UiRect weather_row  = {0, 0, CURRENT_W, 48};
+constexpr UiRect weather_icon = {0, 0, 48, 48};
+constexpr UiRect weather_cond = {weather_icon.w, vcenter(weather_row.h, 22), 212, 22};
+constexpr UiRect weather_temp = {weather_cond.x + weather_cond.w, 0,
+                                 CURRENT_W - (weather_cond.x + weather_cond.w), 48};
+
+constexpr lv_coord_t DETAILS_PAD_TOP = 8;
+constexpr UiRect details_row   = {0, weather_row.h, CURRENT_W, DETAILS_PAD_TOP + 20};
+constexpr UiRect detail_spacer = {(CURRENT_W - 30) / 2, 0, 30, 1};
+constexpr UiRect weather_wind  = {0, 0, detail_spacer.x, 20};
+constexpr UiRect weather_humid = {detail_spacer.x + detail_spacer.w, 0,
+                                  CURRENT_W - (detail_spacer.x + detail_spacer.w), 20};
+
+constexpr UiRect current_card   = {0, 0, RIGHT_W, details_row.y + details_row.h + 2 * CURRENT_PAD};
+constexpr UiRect mid_spacer     = {0, current_card.h, 1, 8};
+constexpr UiRect forecast_title = {0, mid_spacer.y + mid_spacer.h, RIGHT_W, 22};
+constexpr UiRect forecast       = {0, forecast_title.y + forecast_title.h, RIGHT_W, FORECAST_STRIP_H};
+
+static_assert(title.x > wifi_status.x + wifi_status.w, "title overlaps wifi status");
+static_assert(title.x + title.w < unit_toggle.x, "title overlaps unit toggle");
+static_assert(therm_card(2).y + THERM_CARD_H <= CONTENT_H - 2 * LEFT_PAD, "left panel overflow");
+static_assert(forecast.y + forecast.h <= RIGHT_H, "right panel overflow");
+
+}  // namespace ui_layout
@@ -0,0 +1,231 @@
+#include "ui_queue.h"
+#include "config.h"
+#include "event_loop.h"
+#include "serial_console.h"
+#include "ui.h"
+#include <Arduino.h>
+#include <atomic>
+#include <string.h>
+
+static const char* TAG = "UIQ";
+
+static_assert((UI_QUEUE_CAPACITY & (UI_QUEUE_CAPACITY - 1)) == 0, "UI_QUEUE_CAPACITY must be a power of two");
+#define MASK (UI_QUEUE_CAPACITY - 1)
+
+// Bounded MPMC ring (D. Vyukov), used with a single consumer. A cell is free
+// for the producer holding ticket `pos` when seq == pos, and readable by the
+// consumer at `pos` when seq == pos + 1.
+struct Cell {
+    std::atomic<uint32_t> seq;
+    UiCmd cmd;
+};
+
+static Cell cells[UI_QUEUE_CAPACITY];
+static std::atomic<uint32_t> enqueue_pos(0);
+static uint32_t dequeue_pos = 0;   // consumer only
+
+static TripleBuffer<HAWeatherData>* snapshots = nullptr;
+static std::atomic<bool> snapshot_pending(false);
+
+// Producer-side counters; the rest of UiQueueStats is consumer only
+static std::atomic<uint32_t> posted(0);
+static std::atomic<uint32_t> coalesced(0);
+static std::atomic<uint32_t> dropped(0);
+static UiQueueStats stats = {};
+
+// ----- Ring -----
+static bool push(const UiCmd& cmd) {
+    uint32_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cells[pos & MASK];
+        uint32_t seq = cell.seq.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.cmd = cmd;
+                cell.seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;   // full: the consumer has not freed this cell yet
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);   // another producer took it
+        }
+    }
+}
+
+static bool pop(UiCmd& out) {
+    Cell& cell = cells[dequeue_pos & MASK];
+    uint32_t seq = cell.seq.load(std::memory_order_acquire);
+    if ((int32_t)(seq - (dequeue_pos + 1)) < 0) return false;   // empty, or still being written
+    out = cell.cmd;
+    cell.seq.store(dequeue_pos + UI_QUEUE_CAPACITY, std::memory_order_release);
+    dequeue_pos++;
+    return true;
+}
+
+// ----- Producers -----
+static bool post(UiCmdType type, uint8_t arg, float value) {
+    UiCmd cmd = {type, arg, value, (uint32_t)micros()};
+    posted.fetch_add(1, std::memory_order_relaxed);
+    if (!push(cmd)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    event_loop_wake();
+    return true;
+}
+
+bool ui_post_temperature(TempSensor sensor, float celsius) {
+    return post(UI_CMD_TEMPERATURE, (uint8_t)sensor, celsius);
+}
+
+bool ui_post_wifi(bool connected) {
+    return post(UI_CMD_WIFI, connected, 0);
+}
+
+bool ui_post_loading(bool show) {
+    return post(UI_CMD_LOADING, show, 0);
+}
+
+bool ui_post_history() {
+    return post(UI_CMD_HISTORY, 0, 0);
+}
+
+bool ui_post_snapshot() {
+    // One queued snapshot command picks up whatever is newest when it runs
+    if (snapshot_pending.exchange(true, std::memory_order_acq_rel)) {
+        posted.fetch_add(1, std::memory_order_relaxed);
+        coalesced.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    if (post(UI_CMD_SNAPSHOT, 0, 0)) return true;
+    snapshot_pending.store(false, std::memory_order_release);
+    return false;
+}
+
+// ----- Consumer -----
+static void apply_to_dashboard(const UiCmd& cmd) {
+    switch (cmd.type) {
+    case UI_CMD_TEMPERATURE:
+        ui_set_temperature((TempSensor)cmd.arg, cmd.value);
+        break;
+    case UI_CMD_WIFI:
+        ui_set_wifi_status(cmd.arg);
+        break;
+    case UI_CMD_LOADING:
+        ui_show_loading(cmd.arg);
+        break;
+    case UI_CMD_SNAPSHOT:
+        if (snapshots && snapshots->fetch()) ui_update(snapshots->front());
+        break;
+    case UI_CMD_HISTORY:
+        if (temp_history_commit_stage()) ui_history_changed();
+        break;
+    default:
+        break;
+    }
+}
+
+// Commands that overwrite each other: one per sensor, one per other type
+static int target(const UiCmd& cmd) {
+    return cmd.type == UI_CMD_TEMPERATURE ? cmd.arg : TEMP_SENSOR_COUNT + cmd.type;
+}
+
+uint32_t ui_queue_drain(ui_cmd_fn apply) {
+    if (!apply) apply = apply_to_dashboard;
+
+    // Take a bounded batch, so producers can't keep the loop here
+    UiCmd batch[UI_QUEUE_CAPACITY];
+    uint32_t n = 0;
+    while (n < UI_QUEUE_CAPACITY && pop(batch[n])) n++;
+    if (!n) return 0;
+    if (n > stats.max_depth) stats.max_depth = n;
+
+    // Newest command per target wins
+    bool seen[TEMP_SENSOR_COUNT + UI_CMD_TYPES] = {};
+    bool keep[UI_QUEUE_CAPACITY];
+    for (int i = n - 1; i >= 0; i--) {
+        int t = target(batch[i]);
+        keep[i] = !seen[t];
+        seen[t] = true;
+    }
+
+    uint32_t applied = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if (!keep[i]) {
+            coalesced.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (batch[i].type == UI_CMD_SNAPSHOT) snapshot_pending.store(false, std::memory_order_release);
+        apply(batch[i]);
+        applied++;
+
+        uint32_t us = micros() - batch[i].posted_us;
+        if (us > stats.latency_max_us) stats.latency_max_us = us;
+        stats.latency_total_us += us;
+        int b = us ? 31 - __builtin_clz(us) : 0;
+        stats.hist[b < UI_QUEUE_LATENCY_BUCKETS ? b : UI_QUEUE_LATENCY_BUCKETS - 1]++;
+    }
+    stats.applied += applied;
+    return applied;
+}
+
+// ----- Reporting -----
+void ui_queue_get_stats(UiQueueStats& out) {
+    out = stats;
+    out.posted    = posted.load(std::memory_order_relaxed);
+    out.coalesced = coalesced.load(std::memory_order_relaxed);
+    out.dropped   = dropped.load(std::memory_order_relaxed);
+}
+
+uint32_t ui_queue_percentile_us(const UiQueueStats& s, float frac) {
+    uint32_t target = (uint32_t)(s.applied * frac);
+    uint32_t n = 0;
+    for (int b = 0; b < UI_QUEUE_LATENCY_BUCKETS; b++) {
+        n += s.hist[b];
+        if (n > target) return 2u << b;
+    }
+    return 2u << (UI_QUEUE_LATENCY_BUCKETS - 1);
+}
+
+void ui_queue_reset_stats() {
+    memset(&stats, 0, sizeof(stats));
+    posted = 0;
+    coalesced = 0;
+    dropped = 0;
+}
+
+static void cmd_uiq(const char* args) {
+    if (strcmp(args, "reset") == 0) {
+        ui_queue_reset_stats();
+        return;
+    }
+    UiQueueStats s;
+    ui_queue_get_stats(s);
+    uint32_t n = s.applied ? s.applied : 1;
+    Serial.printf("[%s] %lu posted, %lu applied, %lu coalesced, %lu dropped, max batch %lu\n", TAG,
+                  (unsigned long)s.posted, (unsigned long)s.applied, (unsigned long)s.coalesced,
+                  (unsigned long)s.dropped, (unsigned long)s.max_depth);
+    Serial.printf("[%s] post->applied avg %.2f ms, max %.2f ms, p50 <= %.2f ms, p99 <= %.2f ms\n", TAG,
+                  s.latency_total_us / 1000.0 / n, s.latency_max_us / 1000.0,
+                  ui_queue_percentile_us(s, 0.5f) / 1000.0, ui_queue_percentile_us(s, 0.99f) / 1000.0);
+}
+
+static void drain_hook() {
+    ui_queue_drain();
+}
+
+void ui_queue_init(TripleBuffer<HAWeatherData>* snaps) {
+    snapshots = snaps;
+    for (uint32_t i = 0; i < UI_QUEUE_CAPACITY; i++) cells[i].seq.store(i, std::memory_order_relaxed);
+    enqueue_pos.store(0, std::memory_order_relaxed);
+    dequeue_pos = 0;
+    snapshot_pending = false;
+
+    static bool registered = false;
+    if (registered) return;
+    registered = true;
+    event_loop_on_wake(drain_hook);
+    serial_console_add("uiq", "UI command queue from other tasks: uiq [reset]", cmd_uiq);
+}
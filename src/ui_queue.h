@@ -0,0 +1,62 @@
+#pragma once
+#include <stdint.h>
+#include "ha_client.h"
+#include "temp_history.h"
+#include "triple_buffer.h"
+
+// UI mutations posted from any task, applied on the LVGL task. LVGL is not
+// thread-safe, so other tasks never touch widgets: they post a command to a
+// bounded lock-free queue (Vyukov ring, many producers, one consumer), wake
+// the event loop, and the loop drains the queue before lv_timer_handler().
+// Within one drain only the newest command per target is applied (the same
+// sensor, the WiFi icon, the overlay); snapshots coalesce at post time, since
+// the triple buffer always holds the newest anyway.
+
+#define UI_QUEUE_LATENCY_BUCKETS 16   // [2^i, 2^(i+1)) us, last bucket >= ~65 ms
+
+enum UiCmdType : uint8_t {
+    UI_CMD_TEMPERATURE,   // arg = TempSensor, value = celsius
+    UI_CMD_WIFI,          // arg = connected
+    UI_CMD_LOADING,       // arg = show
+    UI_CMD_SNAPSHOT,      // fetch the triple buffer, ui_update()
+    UI_CMD_HISTORY,       // merge the staged temperature history, redraw sparklines
+    UI_CMD_TYPES
+};
+
+struct UiCmd {
+    UiCmdType type;
+    uint8_t   arg;
+    float     value;
+    uint32_t  posted_us;
+};
+
+struct UiQueueStats {
+    uint32_t posted;
+    uint32_t applied;
+    uint32_t coalesced;     // superseded before they were applied
+    uint32_t dropped;       // queue full
+    uint32_t max_depth;     // most commands taken in one drain
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;   // post -> applied, over `applied`
+    uint32_t hist[UI_QUEUE_LATENCY_BUCKETS];
+};
+
+typedef void (*ui_cmd_fn)(const UiCmd& cmd);
+
+// Drains from an event_loop_on_wake() hook; registers the "uiq" command
+void ui_queue_init(TripleBuffer<HAWeatherData>* snapshots);
+
+// Any task. False if the queue is full (counted as dropped).
+bool ui_post_temperature(TempSensor sensor, float celsius);
+bool ui_post_wifi(bool connected);
+bool ui_post_loading(bool show);
+bool ui_post_snapshot();   // after snapshots->publish()
+bool ui_post_history();    // after staging into temp_history (history backfill)
+
+// LVGL task only. Applies through `apply` (the dashboard by default);
+// returns the number of commands applied.
+uint32_t ui_queue_drain(ui_cmd_fn apply = nullptr);
+
+void ui_queue_get_stats(UiQueueStats& out);
+uint32_t ui_queue_percentile_us(const UiQueueStats& s, float frac);   // bucket upper bound
+void ui_queue_reset_stats();
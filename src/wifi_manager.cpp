@@ -4,6 +4,7 @@
 
 static unsigned long last_reconnect_attempt = 0;
 static const unsigned long RECONNECT_INTERVAL_MS = 10000;
+static void (*change_cb)() = nullptr;
 
 void wifi_init() {
     WiFi.mode(WIFI_STA);
@@ -29,6 +30,10 @@ bool wifi_is_connected() {
     return WiFi.status() == WL_CONNECTED;
 }
 
+int wifi_rssi() {
+    return wifi_is_connected() ? WiFi.RSSI() : 0;
+}
+
 void wifi_check_reconnect() {
     if (WiFi.status() == WL_CONNECTED) return;
 
@@ -40,3 +45,14 @@ void wifi_check_reconnect() {
     WiFi.disconnect();
     WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
 }
+
+static void on_wifi_event(arduino_event_id_t event) {
+    (void)event;
+    if (change_cb) change_cb();
+}
+
+void wifi_on_change(void (*cb)()) {
+    change_cb = cb;
+    WiFi.onEvent(on_wifi_event, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+    WiFi.onEvent(on_wifi_event, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+}
@@ -3,4 +3,7 @@
 
 void wifi_init();
 bool wifi_is_connected();
+int  wifi_rssi();   // dBm, 0 when disconnected
 void wifi_check_reconnect();
+// Called from the WiFi event task when the connection comes up or drops
+void wifi_on_change(void (*cb)());
@@ -0,0 +1,254 @@
+"""Generate subset fonts holding only the glyphs the UI uses.
+
+PlatformIO pre-script (extra_scripts = pre:tools/gen_fonts.py). Does nothing
+unless the environment builds with -DUI_SUBSET_FONTS=1. Then it:
+
+  * scans the sources that include ui_fonts.h (plus weather_icons.h) for
+    string literals, LV_SYMBOL_* and ICON_* names and the UI_FONT_<size> /
+    UI_FONT_WEATHER_<size> macros they use,
+  * runs lv_font_conv for every size used, writing ui_font_montserrat_<size>.c
+    and a compressed ui_font_montserrat_<size>_z.c to src/fonts/generated/
+    (same for the MDI weather icons when the MDI font file is found),
+  * prints flash usage of the subset fonts next to the LVGL built-ins.
+
+Also runs standalone:  python tools/gen_fonts.py --lvgl <lvgl dir> [--mdi <ttf>]
+"""
+
+import argparse
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+try:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+except NameError:  # SCons exec()s extra scripts without __file__; set below
+    ROOT = os.getcwd()
+SRC_DIR = os.path.join(ROOT, "src")
+OUT_DIR = os.path.join(SRC_DIR, "fonts", "generated")
+STAMP = os.path.join(OUT_DIR, ".stamp")
+
+# Text built at runtime rather than from literals: numbers, times, strftime
+# day names and the basic punctuation around them
+ALWAYS_TEXT = "0123456789 +-.,:%/()° MonTueWedThuFriSatSun CF HL"
+ALWAYS_SIZES = {14}   # LV_FONT_DEFAULT
+BPP = 4
+
+STRING_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+SYMBOL_DEF_RE = re.compile(r'#define\s+(LV_SYMBOL_\w+)\s+"((?:[^"\\]|\\.)*)"')
+ICON_DEF_RE = re.compile(r'#define\s+(ICON_\w+)\s+"((?:[^"\\]|\\.)*)"')
+
+
+def c_unescape(lit):
+    """Decode a C string literal body into bytes."""
+    out = bytearray()
+    i = 0
+    while i < len(lit):
+        c = lit[i]
+        if c != "\\":
+            out += c.encode("utf-8")
+            i += 1
+            continue
+        n = lit[i + 1]
+        if n == "x":
+            m = re.match(r"[0-9a-fA-F]{1,2}", lit[i + 2:])
+            out.append(int(m.group(0), 16))
+            i += 2 + len(m.group(0))
+        elif n in "01234567":
+            m = re.match(r"[0-7]{1,3}", lit[i + 1:])
+            out.append(int(m.group(0), 8))
+            i += 1 + len(m.group(0))
+        else:
+            out += {"n": b"\n", "t": b"\t", "r": b"\r", "0": b"\0"}.get(n, n.encode())
+            i += 2
+    return bytes(out)
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def literal_text(text):
+    """Concatenate string literals of a source file (adjacent literals join)."""
+    text = strip_comments(text)
+    text = "\n".join(l for l in text.splitlines() if not l.lstrip().startswith("#include"))
+    # Adjacent literals like "\xC2\xB0" "F" form one UTF-8 sequence
+    text = re.sub(r'"\s*"', "", text)
+    chunks = [c_unescape(m.group(1)) for m in STRING_RE.finditer(text)]
+    return b"".join(chunks).decode("utf-8", errors="ignore")
+
+
+def read_sources():
+    """Sources that draw text: everything including ui_fonts.h, plus the
+    condition labels and icon codepoints in weather_icons.h."""
+    sources = {}
+    for name in sorted(os.listdir(SRC_DIR)):
+        if not name.endswith((".cpp", ".h")) or name == "ui_fonts.h":
+            continue
+        with open(os.path.join(SRC_DIR, name), encoding="utf-8") as f:
+            body = f.read()
+        if name == "weather_icons.h" or '#include "ui_fonts.h"' in body:
+            sources[name] = body
+    return sources
+
+
+def scan(sources, symbol_defs, icon_defs):
+    text = ALWAYS_TEXT
+    for name, body in sources.items():
+        if name == "weather_icons.h":
+            # Only the labels; the icon defines go to the weather font
+            body = ICON_DEF_RE.sub("", body)
+        text += literal_text(body)
+    glyphs = {ord(c) for c in text if ord(c) >= 0x20 and ord(c) < 0xE000}
+
+    code = "\n".join(strip_comments(b) for b in sources.values())
+    symbols = {symbol_defs[s] for s in set(re.findall(r"\bLV_SYMBOL_\w+", code)) if s in symbol_defs}
+    icon_uses = re.findall(r"\bICON_\w+", ICON_DEF_RE.sub("", code))
+    icons = {icon_defs[s] for s in icon_uses if s in icon_defs}
+
+    sizes = {int(s) for s in re.findall(r"\bUI_FONT_(\d+)\b", code)} | ALWAYS_SIZES
+    weather_sizes = {int(s) for s in re.findall(r"\bUI_FONT_WEATHER_(\d+)\b", code)}
+    return glyphs, symbols, icons, sizes, weather_sizes
+
+
+def codepoint_defs(path, regex):
+    defs = {}
+    with open(path, encoding="utf-8") as f:
+        for m in regex.finditer(f.read()):
+            s = c_unescape(m.group(2)).decode("utf-8", errors="ignore")
+            if len(s) == 1:
+                defs[m.group(1)] = ord(s)
+    return defs
+
+
+def ranges(cps):
+    return ",".join("0x%X" % c for c in sorted(cps))
+
+
+def font_conv_cmd():
+    exe = shutil.which("lv_font_conv")
+    if exe:
+        return [exe]
+    npx = shutil.which("npx")
+    if npx:
+        return [npx, "--yes", "lv_font_conv"]
+    sys.exit("gen_fonts: lv_font_conv not found (npm install -g lv_font_conv)")
+
+
+def run_font_conv(name, size, parts, compress):
+    out = os.path.join(OUT_DIR, name + ".c")
+    cmd = font_conv_cmd() + ["--bpp", str(BPP), "--size", str(size), "--no-prefilter",
+                             "--format", "lvgl", "--lv-include", "lvgl.h",
+                             "--lv-font-name", name, "--force-fast-kern-format", "-o", out]
+    if not compress:
+        cmd.append("--no-compress")
+    for font, cps in parts:
+        if cps:
+            cmd += ["--font", font, "-r", ranges(cps)]
+    subprocess.check_call(cmd)
+    return out
+
+
+def bitmap_bytes(path):
+    """Size of glyph_bitmap[] in a generated LVGL font source."""
+    if not os.path.exists(path):
+        return 0
+    with open(path, encoding="utf-8", errors="ignore") as f:
+        m = re.search(r"glyph_bitmap\[\]\s*=\s*\{(.*?)\};", f.read(), re.S)
+    return len(re.findall(r"0x[0-9a-fA-F]+", strip_comments(m.group(1)))) if m else 0
+
+
+def generate(lvgl_dir, mdi_ttf):
+    symbol_defs = codepoint_defs(os.path.join(lvgl_dir, "src", "font", "lv_symbol_def.h"), SYMBOL_DEF_RE)
+    icon_defs = codepoint_defs(os.path.join(SRC_DIR, "weather_icons.h"), ICON_DEF_RE)
+    glyphs, symbols, icons, sizes, weather_sizes = scan(read_sources(), symbol_defs, icon_defs)
+
+    font_dir = os.path.join(lvgl_dir, "scripts", "built_in_font")
+    text_font = os.path.join(font_dir, "Montserrat-Medium.ttf")
+    symbol_font = os.path.join(font_dir, "FontAwesome5-Solid+Brands-Regular.woff")
+    has_weather = bool(mdi_ttf and os.path.exists(mdi_ttf) and weather_sizes)
+
+    key = repr((sorted(glyphs), sorted(symbols), sorted(icons), sorted(sizes),
+                sorted(weather_sizes), has_weather, BPP)).encode()
+    digest = hashlib.sha1(key).hexdigest()
+    if os.path.exists(STAMP) and open(STAMP).read() == digest:
+        return has_weather
+
+    shutil.rmtree(OUT_DIR, ignore_errors=True)
+    os.makedirs(OUT_DIR)
+    print("gen_fonts: %d glyphs + %d symbols, sizes %s" % (len(glyphs), len(symbols), sorted(sizes)))
+
+    report = []
+    for size in sorted(sizes):
+        parts = [(text_font, glyphs), (symbol_font, symbols)]
+        plain = run_font_conv("ui_font_montserrat_%d" % size, size, parts, False)
+        packed = run_font_conv("ui_font_montserrat_%d_z" % size, size, parts, True)
+        builtin = os.path.join(lvgl_dir, "src", "font", "lv_font_montserrat_%d.c" % size)
+        report.append(("montserrat_%d" % size, bitmap_bytes(builtin), bitmap_bytes(plain), bitmap_bytes(packed)))
+
+    if has_weather:
+        for size in sorted(weather_sizes):
+            parts = [(mdi_ttf, icons)]
+            plain = run_font_conv("ui_font_weather_%d" % size, size, parts, False)
+            packed = run_font_conv("ui_font_weather_%d_z" % size, size, parts, True)
+            checked_in = os.path.join(SRC_DIR, "weather_font_%d.c" % size)
+            report.append(("weather_%d" % size, bitmap_bytes(checked_in), bitmap_bytes(plain), bitmap_bytes(packed)))
+    elif weather_sizes:
+        print("gen_fonts: MDI font not found, keeping checked-in weather fonts (set MDI_FONT_TTF)")
+
+    total = [0, 0, 0]
+    print("gen_fonts: glyph bitmap bytes      built-in     subset  subset+z")
+    for name, full, sub, z in report:
+        print("gen_fonts:   %-20s %10d %10d %9d" % (name, full, sub, z))
+        total = [total[0] + full, total[1] + sub, total[2] + z]
+    print("gen_fonts:   %-20s %10d %10d %9d" % ("total", total[0], total[1], total[2]))
+
+    with open(STAMP, "w") as f:
+        f.write(digest)
+    return has_weather
+
+
+def build_flag(flags, name):
+    m = re.search(r"-D\s*%s(?:=(\w+))?" % name, flags)
+    return bool(m) and m.group(1) not in ("0", "false")
+
+
+def default_mdi():
+    return os.environ.get("MDI_FONT_TTF", os.path.join(ROOT, "tools", "fonts", "materialdesignicons-webfont.ttf"))
+
+
+try:
+    Import("env")  # noqa: F821 (SCons)
+except NameError:
+    env = None
+
+if env is not None:
+    ROOT = env.subst("$PROJECT_DIR")
+    SRC_DIR = os.path.join(ROOT, "src")
+    OUT_DIR = os.path.join(SRC_DIR, "fonts", "generated")
+    STAMP = os.path.join(OUT_DIR, ".stamp")
+
+    flags = env.GetProjectOption("build_flags", "")
+    if isinstance(flags, list):
+        flags = " ".join(flags)
+    if not build_flag(flags, "UI_SUBSET_FONTS"):
+        shutil.rmtree(OUT_DIR, ignore_errors=True)
+    else:
+        lvgl_dir = os.path.join(env.subst("$PROJECT_LIBDEPS_DIR"), env.subst("$PIOENV"), "lvgl")
+        if not os.path.isdir(lvgl_dir):
+            sys.exit("gen_fonts: %s missing, run `pio pkg install -e %s` first" % (lvgl_dir, env.subst("$PIOENV")))
+        if generate(lvgl_dir, default_mdi()):
+            # Generated icon fonts replace the checked-in ones
+            env.Append(CPPDEFINES=["UI_SUBSET_WEATHER_FONTS", ("WEATHER_FONT_24", 0), ("WEATHER_FONT_40", 0)])
+elif __name__ == "__main__":
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--lvgl", required=True, help="LVGL source directory (e.g. .pio/libdeps/native/lvgl)")
+    ap.add_argument("--mdi", default=default_mdi(), help="materialdesignicons-webfont.ttf")
+    ap.add_argument("--force", action="store_true", help="regenerate even if up to date")
+    args = ap.parse_args()
+    if args.force and os.path.exists(STAMP):
+        os.remove(STAMP)
+    generate(args.lvgl, args.mdi)